@@ -0,0 +1,329 @@
+///\file
+/// Non-interactive batch mode: answers a file of queries on a graph loaded once, writing one CSV or JSON line each.
+/// The read-only queries are spread over a thread pool, each worker with its own QueryWorkspace on a shared CsrGraph,
+/// and widest path queries from a repeated origin are looked up in a WidestPathTable
+
+#ifndef BATCHRUNNER_H_
+#define BATCHRUNNER_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <fstream>
+#include <future>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include "CsrGraph.h"
+#include "Graph.h"
+#include "QueryWorkspace.h"
+#include "ThreadPool.h"
+#include "WidestPathTable.h"
+
+///One line of a query file: "algorithm origin target [group [increase]]"
+///The algorithms are the menu options: 1.1 widest path, 1.2 Pareto-optimal paths, 2.1 paths for a group of the given
+///size, 2.2 2.1 followed by an increase of the group, 2.3 maximum flow (Edmonds-Karp), 2.4 soonest reunion and
+///2.5 waiting times. 2.4 and 2.5 run on the flux of 2.1 with the given group or, without one, of 2.3.
+///sp, not in the menu, is the path with the shortest total duration (Dijkstra)
+///For example "2.2 1 4 5 2" routes a group of 5 from 1 to 4, then adds 2 people to it. A line naming a vertex the
+///graph doesn't have gets the status "unknown vertex". One whose origin is its target, such as "2.1 1 1 5", is
+///answered like the menu answers it: there, the whole group stays on the single-vertex path
+struct BatchQuery {
+    int line = 0;              // line of the query file, 1-based
+    std::string algorithm;
+    int origin = 0;
+    int target = 0;
+    int group = 0;             // 0 if not given
+    int increase = 0;          // 2.2 only
+    std::string error;         // why the line can't be run, empty if it's valid
+};
+
+///Answer to a query, holding what the menu prints for it
+struct BatchResult {
+    BatchQuery query;
+    std::string status;        // "ok", "partial" if the group doesn't fit, "no path", or why the query failed
+    long long value = 0;       // 1.1 width, 1.2 number of paths, 2.1 group routed, 2.2 increase (-1 if it doesn't
+                               // fit), 2.3 maximum flow, 2.4 reunion time, 2.5 biggest waiting time, sp duration
+    PathStore<int> paths;      // paths and their group sizes, widths or durations: 1.x, 2.1 to 2.3 and sp
+    std::vector<std::pair<int, int>> waits;    // 2.5: waiting time of each vertex where people wait
+    double latencyMicros = 0;  // time spent running the algorithms
+};
+
+///Outcome of a batch
+struct BatchReport {
+    int queries = 0;            // queries answered
+    int tableSources = 0;       // sources of the widest path table, 0 if none was built
+    size_t tableBytes = 0;      // memory taken by that table
+    long tableMicros = 0;       // time spent building it
+    std::string error;          // why the batch couldn't run, empty on success
+};
+
+///Reads a query file; blank lines and lines starting with '#' are skipped
+///\param path path of the query file
+///\param queries receives the queries, with the error set on the malformed ones
+///@return false if the file can't be read
+inline bool readQueries(const std::string &path, std::vector<BatchQuery> &queries) {
+    std::ifstream file(path);
+    if (!file) return false;
+    std::string text;
+    for (int line = 1; std::getline(file, text); line++) {
+        std::istringstream fields(text);
+        BatchQuery query;
+        query.line = line;
+        if (!(fields >> query.algorithm) || query.algorithm[0] == '#') continue;
+        if (!(fields >> query.origin >> query.target)) query.error = "invalid query";
+        else if (!(fields >> query.group)) fields.clear();
+        else if (!(fields >> query.increase)) fields.clear();
+        std::string extra;
+        if (query.error.empty() && fields >> extra) query.error = "invalid query";
+        queries.push_back(query);
+    }
+    return true;
+}
+
+///Sets the flux 2.4 and 2.5 run on
+///@return false if the given group doesn't fit
+inline bool batchFlux(Graph<int> &graph, const BatchQuery &query) {
+    if (query.group > 0) return graph.FindPathGivenGroupSize(query.origin, query.target, query.group) == query.group;
+    graph.edmondKarpFlux(query.origin, query.target);
+    return true;
+}
+
+///@return whether a query only reads the graph, so it can run on a QueryWorkspace at the same time as others
+inline bool isReadOnly(const BatchQuery &query) {
+    return query.algorithm == "1.1" || query.algorithm == "sp";
+}
+
+///Checks a query before it runs
+///\param found whether its origin and target are vertices of the graph
+///@return "ok", or why it can't run
+inline std::string checkQuery(const BatchQuery &query, bool found) {
+    const std::string &algorithm = query.algorithm;
+    bool needsGroup = algorithm == "2.1" || algorithm == "2.2";
+    if (!query.error.empty()) return query.error;
+    if (!found) return "unknown vertex";
+    if ((needsGroup && query.group < 1) || (algorithm == "2.2" && query.increase < 1) || query.group < 0) {
+        return "invalid query";
+    }
+    return "ok";
+}
+
+///Runs a read-only query on a workspace, or looks it up in table, timing it
+///\param csr graph of the workspace and the table
+///\param table widest paths from some origins, nullptr if there's none
+inline BatchResult runQuery(QueryWorkspace<int> &workspace, const CsrGraph<int> &csr,
+                            const WidestPathTable<int> *table, const BatchQuery &query) {
+    BatchResult res;
+    res.query = query;
+    int s = csr.findVertexIdx(query.origin), t = csr.findVertexIdx(query.target);
+    res.status = checkQuery(query, s != -1 && t != -1);
+    if (res.status != "ok") return res;
+    auto start = std::chrono::steady_clock::now();
+    int value;
+    std::vector<int> path;
+    if (query.algorithm == "1.1" && table != nullptr && table->hasSource(s)) {
+        value = table->getWidth(s, t);
+        path = table->getPath(s, t);
+    } else {
+        value = query.algorithm == "1.1" ? workspace.widestPath(s, t) : workspace.shortestPath(s, t);
+        path = workspace.getPath(s, t);
+    }
+    if (path.empty()) res.status = "no path";
+    else {
+        res.paths.add(path, value);
+        res.value = value;
+    }
+    res.latencyMicros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    return res;
+}
+
+///Runs a query that changes the graph's flux or scratch fields, timing it
+inline BatchResult runQuery(Graph<int> &graph, const BatchQuery &query) {
+    BatchResult res;
+    res.query = query;
+    bool found = graph.findVertex(query.origin) != nullptr && graph.findVertex(query.target) != nullptr;
+    res.status = checkQuery(query, found);
+    if (res.status != "ok") return res;
+    const std::string &algorithm = query.algorithm;
+    auto start = std::chrono::steady_clock::now();
+    graph.paths.clear();
+    if (algorithm == "1.2") {
+        graph.paretoOptimalGroupSizeAndTransportShift(query.origin, query.target);
+        res.value = graph.paths.size();
+    } else if (algorithm == "2.1") {
+        res.value = graph.FindPathGivenGroupSize(query.origin, query.target, query.group);
+        if (res.value < query.group) res.status = "partial";
+    } else if (algorithm == "2.2") {
+        if (graph.FindPathGivenGroupSize(query.origin, query.target, query.group) < query.group) res.status = "partial";
+        res.value = graph.increaseGroupSize(query.origin, query.target, query.increase);
+        if (res.value < 0) res.status = "partial";
+    } else if (algorithm == "2.3") {
+        res.value = graph.edmondKarpFlux(query.origin, query.target);
+    } else if (algorithm == "2.4") {
+        if (!batchFlux(graph, query)) res.status = "partial";
+        res.value = graph.longestPath(query.origin, query.target);
+        if (res.value == NINF) res.status = "no path";
+        graph.paths.clear();
+    } else if (algorithm == "2.5") {
+        if (!batchFlux(graph, query)) res.status = "partial";
+        WaitingTimes<int> times = graph.waitingTimes(query.origin, query.target);
+        res.value = times.biggest;
+        res.waits = std::move(times.waits);
+        graph.paths.clear();
+    } else {
+        res.status = "unknown algorithm";
+    }
+    res.latencyMicros = std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+    res.paths = graph.paths;
+    return res;
+}
+
+///@return the algorithm of a query, as read, without the characters that would break a CSV or JSON line
+inline std::string printableAlgorithm(const BatchQuery &query) {
+    std::string algorithm;
+    for (char c : query.algorithm) {
+        if (std::isalnum((unsigned char) c) || c == '.') algorithm += c;
+    }
+    return algorithm;
+}
+
+///Writes the CSV header line
+inline void writeCsvHeader(std::ostream &out) {
+    out << "line,algorithm,origin,target,group,increase,status,value,paths,waits,latency_us\n";
+}
+
+///Writes a result as a CSV line: paths as "amount:v1-v2-...", waits as "vertex:wait", both space separated,
+///paths in the order the menu prints them
+inline void writeCsv(std::ostream &out, const BatchResult &res) {
+    const BatchQuery &query = res.query;
+    out << query.line << ',' << printableAlgorithm(query) << ',' << query.origin << ',' << query.target << ','
+        << query.group << ',' << query.increase << ',' << res.status << ',' << res.value << ',';
+    const char *sep = "";
+    for (int id : res.paths.lexicographicOrder()) {
+        out << sep << res.paths.getAmount(id) << ':';
+        for (const int *v = res.paths.begin(id); v != res.paths.end(id); v++) {
+            out << (v == res.paths.begin(id) ? "" : "-") << *v;
+        }
+        sep = " ";
+    }
+    out << ',';
+    sep = "";
+    for (const std::pair<int, int> &wait : res.waits) {
+        out << sep << wait.first << ':' << wait.second;
+        sep = " ";
+    }
+    out << ',' << res.latencyMicros << '\n';
+}
+
+///Writes a result as a JSON object on its own line
+inline void writeJson(std::ostream &out, const BatchResult &res) {
+    const BatchQuery &query = res.query;
+    out << "{\"line\":" << query.line << ",\"algorithm\":\"" << printableAlgorithm(query) << "\",\"origin\":"
+        << query.origin << ",\"target\":" << query.target << ",\"group\":" << query.group << ",\"increase\":"
+        << query.increase << ",\"status\":\"" << res.status << "\",\"value\":" << res.value << ",\"paths\":[";
+    const char *sep = "";
+    for (int id : res.paths.lexicographicOrder()) {
+        out << sep << "{\"amount\":" << res.paths.getAmount(id) << ",\"path\":[";
+        for (const int *v = res.paths.begin(id); v != res.paths.end(id); v++) {
+            out << (v == res.paths.begin(id) ? "" : ",") << *v;
+        }
+        out << "]}";
+        sep = ",";
+    }
+    out << "],\"waits\":[";
+    sep = "";
+    for (const std::pair<int, int> &wait : res.waits) {
+        out << sep << "{\"vertex\":" << wait.first << ",\"wait\":" << wait.second << '}';
+        sep = ",";
+    }
+    out << "],\"latency_us\":" << res.latencyMicros << "}\n";
+}
+
+///Answers every query of a file, writing a line per query, in the file's order, to the output file: JSON lines if
+///its name ends in ".json" or ".jsonl", CSV with a header line otherwise.
+///The read-only queries are handed out to the workers of a thread pool, each reusing one QueryWorkspace for all of
+///its queries, while the calling thread runs the others, in order, on graph. When some origin has more than one
+///widest path query, a WidestPathTable of the origins of those queries is built first, so each of them costs one
+///widest path run in all instead of one per query
+///\param graph loaded graph the queries run on
+///\param queryPath path of the query file
+///\param outputPath path of the file the results are written to
+///\param threads number of workers for the read-only queries and the table
+///\param report receives the number of queries, what the table took and, on failure, the reason
+///@return true if every query was answered and written
+inline bool runBatch(Graph<int> &graph, const std::string &queryPath, const std::string &outputPath, int threads,
+                     BatchReport &report) {
+    std::vector<BatchQuery> queries;
+    if (!readQueries(queryPath, queries)) {
+        report.error = "can't read " + queryPath;
+        return false;
+    }
+    std::ofstream out(outputPath);
+    if (!out) {
+        report.error = "can't write " + outputPath;
+        return false;
+    }
+    auto endsWith = [&outputPath](const std::string &suffix) {
+        return outputPath.size() >= suffix.size() &&
+               outputPath.compare(outputPath.size() - suffix.size(), suffix.size(), suffix) == 0;
+    };
+    bool json = endsWith(".json") || endsWith(".jsonl");
+    if (!json) writeCsvHeader(out);
+    std::vector<BatchResult> results(queries.size());
+    std::vector<int> readOnly;
+    for (size_t i = 0; i < queries.size(); i++) {
+        if (isReadOnly(queries[i])) readOnly.push_back(i);
+    }
+    if (!readOnly.empty()) {
+        // a frozen copy, so the flux the other queries write doesn't matter to the workers
+        CsrGraph<int> csr(graph);
+        std::vector<int> origins;
+        for (int i : readOnly) {
+            int s = csr.findVertexIdx(queries[i].origin);
+            if (queries[i].algorithm == "1.1" && s != -1) origins.push_back(s);
+        }
+        std::vector<int> distinct = origins;
+        std::sort(distinct.begin(), distinct.end());
+        distinct.erase(std::unique(distinct.begin(), distinct.end()), distinct.end());
+        std::unique_ptr<WidestPathTable<int>> table;
+        if (distinct.size() < origins.size()) {
+            table.reset(new WidestPathTable<int>(csr, distinct, threads));
+            report.tableSources = table->getNumSources();
+            report.tableBytes = table->getBytes();
+            report.tableMicros = table->getBuildMicros();
+        }
+        ThreadPool pool(threads);
+        std::atomic<size_t> next{0};
+        std::vector<std::future<void>> done;
+        for (int worker = 0; worker < pool.size(); worker++) {
+            done.push_back(pool.submit([&] {
+                QueryWorkspace<int> workspace(csr);
+                for (size_t i = next++; i < readOnly.size(); i = next++) {
+                    results[readOnly[i]] = runQuery(workspace, csr, table.get(), queries[readOnly[i]]);
+                }
+            }));
+        }
+        for (size_t i = 0; i < queries.size(); i++) {
+            if (!isReadOnly(queries[i])) results[i] = runQuery(graph, queries[i]);
+        }
+        for (std::future<void> &f : done) f.get();
+    } else {
+        for (size_t i = 0; i < queries.size(); i++) results[i] = runQuery(graph, queries[i]);
+    }
+    for (const BatchResult &res : results) {
+        if (json) writeJson(out, res);
+        else writeCsv(out, res);
+    }
+    if (!out) {
+        report.error = "can't write " + outputPath;
+        return false;
+    }
+    report.queries = queries.size();
+    return true;
+}
+
+#endif /* BATCHRUNNER_H_ */
@@ -0,0 +1,50 @@
+///\file
+/// Results of the timing analyses of the flow-carrying subgraph, see Graph::criticalPath and Graph::waitingTimes
+
+#ifndef CRITICALPATH_H_
+#define CRITICALPATH_H_
+
+#include <utility>
+#include <vector>
+
+///Timing of an event (vertex) of the network
+template <class T>
+struct CpmNode {
+    T info;
+    bool onNetwork = false;   // reached from the origin and reaching the target over edges carrying flux
+    int earliest = 0;         // earliest time the event can happen: longest duration from the origin
+    int latest = 0;           // latest time it can happen without delaying the target
+    int totalFloat = 0;       // latest - earliest
+    int freeFloat = 0;        // delay that leaves the earliest time of every successor unchanged
+};
+
+///Timing of an activity (edge carrying flux) of the network
+template <class T>
+struct CpmEdge {
+    T from, to;
+    int duration = 0;
+    int earliestStart = 0, earliestFinish = 0;
+    int latestStart = 0, latestFinish = 0;
+    int totalFloat = 0;       // latestStart - earliestStart: delay that leaves the target on time
+    int freeFloat = 0;        // delay that leaves the earliest time of its head unchanged
+    bool critical = false;    // no total float
+};
+
+///Critical path analysis from an origin to a target
+template <class T>
+struct CriticalPath {
+    int duration = 0;                  // earliest time of the target, 0 if no flux reaches it
+    std::vector<CpmNode<T>> nodes;     // one per vertex, in vertex set order
+    std::vector<CpmEdge<T>> edges;     // one per edge carrying flux between vertices on the network
+    std::vector<int> criticalEdges;    // positions in edges of the critical ones
+};
+
+///Where people wait for each other when everybody leaves the origin at the same time (2.5)
+template <class T>
+struct WaitingTimes {
+    std::vector<std::pair<T, int>> waits;  // latest minus earliest arrival of every vertex where it isn't 0
+    int biggest = 0;                       // biggest of those waiting times, 0 if nobody waits
+    std::vector<T> biggestNodes;           // vertices where the biggest waiting time happens
+};
+
+#endif /* CRITICALPATH_H_ */
@@ -0,0 +1,781 @@
+///\file
+/// Frozen compressed sparse row (CSR) representation of a Graph and the algorithms that run on it
+
+#ifndef CSRGRAPH_H_
+#define CSRGRAPH_H_
+
+#include <vector>
+#include <unordered_map>
+#include <limits>
+#include <algorithm>
+#include <utility>
+#include "DaryHeap.h"
+#include "PathStore.h"
+
+template <class T> class Edge;
+template <class T> class Graph;
+template <class T> class ParallelPushRelabel;
+template <class T> class PathEnumerator;
+
+/************************* CsrGraph  **************************/
+
+///Contiguous, read-only copy of a Graph, built once loading is done.
+///Vertices are addressed by their position in the source graph's vertexSet and edges by their position in the
+///edge arrays: the outgoing edges of v are [offset[v], offset[v+1]), in the same order as v's adjacency list.
+///Edge attributes are kept as a structure of arrays so the hot loops only touch the fields they read.
+template <class T>
+class CsrGraph {
+    std::vector<T> info;           // contents of each vertex
+    std::unordered_map<T, int> index;  // info -> vertex index
+    std::vector<int> offset;       // first outgoing edge of each vertex, plus a sentinel
+    std::vector<int> dest;         // destination vertex of each edge
+    std::vector<int> source;       // origin vertex of each edge
+    std::vector<int> capacity;
+    std::vector<int> duration;
+    std::vector<int> flux;
+    std::vector<int> inOffset;     // first incoming edge (in inEdge) of each vertex, plus a sentinel
+    std::vector<int> inEdge;       // edge ids grouped by destination vertex
+
+    // results of the last query and scratch space of the flow algorithms, indexed by vertex, reused between runs
+    std::vector<int> dist;         // queries: distance, Dinic: BFS level, push-relabel: label
+    std::vector<int> cap;          // widest path: width
+    std::vector<int> pred;         // queries: edge the vertex was reached by, Edmonds-Karp: arc; -1 if none
+    std::vector<int> order;        // BFS queue, topological order, or the DFS stack of decomposeFlux
+    DaryHeap<int> heap;            // Dijkstra's queue
+    DaryHeap<std::pair<int, int>> widthHeap; // widest path queue: (-width, order of widening)
+    std::vector<int> current;      // Dinic, push-relabel: next arc to try at each vertex
+    std::vector<int> arcStack;     // Dinic: arcs of the path being explored
+    std::vector<int> excess;       // push-relabel: flow in minus flow out of each vertex
+    std::vector<int> labelCount;   // push-relabel: number of vertices with each label
+    std::vector<int> bucketHead;   // push-relabel: first active vertex with each label
+    std::vector<int> bucketNext;   // push-relabel: next active vertex with the same label
+    std::vector<char> inBucket;
+
+    void buildIndex();
+    bool buildLevelGraph(int s, int t);
+    void globalRelabel(int sink, int source);
+    void activate(int v, int sink, int source);
+    void pushRelabelPhase(int sink, int source);
+    int arcCount(int v) const;
+    int arcAt(int v, int i) const;
+    int residual(int arc) const;
+    int arcHead(int arc) const;
+    int arcTail(int arc) const;
+    const std::vector<int> &fluxTopologicalOrder();
+
+    friend class ParallelPushRelabel<T>;
+    friend class PathEnumerator<T>;
+
+public:
+    static constexpr int INFTY = std::numeric_limits<int>::max();
+    static constexpr int NINFTY = std::numeric_limits<int>::min();
+
+    PathStore<T> paths;
+
+    CsrGraph() = default;
+    explicit CsrGraph(const Graph<T> &graph);
+
+    int getNumVertex() const;
+    int getNumEdges() const;
+    int findVertexIdx(const T &in) const;
+    const T &getInfo(int v) const;
+    int getDist(int v) const;
+    int getCap(int v) const;
+    int getFlux(int e) const;
+    int edgesBegin(int v) const;
+    int edgesEnd(int v) const;
+    int getDest(int e) const;
+    int getCapacity(int e) const;
+    int getDuration(int e) const;
+
+    void zeroFlux();
+    void readFlux(const Graph<T> &graph);
+    void writeFlux(Graph<T> &graph) const;
+
+    void unweightedShortestPath(int s);
+    void dijkstraShortestPath(int s);
+    int widestPath(int s, int t);
+    int edmondKarpFlux(int s, int t);
+    int dinicFlux(int s, int t);
+    int pushRelabelFlux(int s, int t);
+    bool decomposeFlux(int s, int t);
+    int longestPath(int s, int t);
+    std::vector<T> getPath(int s, int t) const;
+};
+
+///Freezes a graph: copies its vertices and edges into contiguous arrays
+///\param graph the graph to copy; vertex i of the CSR graph is graph's i-th vertex
+template <class T>
+CsrGraph<T>::CsrGraph(const Graph<T> &graph) {
+    int n = graph.vertexSet.size();
+    info.reserve(n);
+    offset.assign(n + 1, 0);
+    for (int v = 0; v < n; v++) {
+        info.push_back(graph.vertexSet[v]->info);
+        offset[v + 1] = offset[v] + graph.vertexSet[v]->adj.size();
+    }
+    int m = offset[n];
+    dest.resize(m);
+    capacity.resize(m);
+    duration.resize(m);
+    flux.resize(m);
+    for (int v = 0; v < n; v++) {
+        int e = offset[v];
+        for (const Edge<T> &edge : graph.vertexSet[v]->adj) {
+            dest[e] = edge.dest->idx;
+            capacity[e] = edge.capacity;
+            duration[e] = edge.duration;
+            flux[e] = edge.flux;
+            e++;
+        }
+    }
+    buildIndex();
+}
+
+///Fills the lookup and reverse adjacency arrays
+template <class T>
+void CsrGraph<T>::buildIndex() {
+    int n = info.size(), m = dest.size();
+    index.clear();
+    index.reserve(n);
+    for (int v = 0; v < n; v++) index[info[v]] = v;
+
+    source.resize(m);
+    inOffset.assign(n + 1, 0);
+    for (int v = 0; v < n; v++) {
+        for (int e = offset[v]; e < offset[v + 1]; e++) {
+            source[e] = v;
+            inOffset[dest[e] + 1]++;
+        }
+    }
+    for (int v = 0; v < n; v++) inOffset[v + 1] += inOffset[v];
+    inEdge.resize(m);
+    std::vector<int> next(inOffset.begin(), inOffset.end() - 1);
+    for (int e = 0; e < m; e++) inEdge[next[dest[e]]++] = e;
+
+    dist.assign(n, 0);
+    cap.assign(n, 0);
+    pred.assign(n, -1);
+    order.reserve(n);
+    current.assign(n, 0);
+}
+
+template <class T>
+int CsrGraph<T>::getNumVertex() const {
+    return info.size();
+}
+
+template <class T>
+int CsrGraph<T>::getNumEdges() const {
+    return dest.size();
+}
+
+///@return index of the vertex with the given content, or -1 if there is none
+template <class T>
+int CsrGraph<T>::findVertexIdx(const T &in) const {
+    auto it = index.find(in);
+    return it == index.end() ? -1 : it->second;
+}
+
+template <class T>
+const T &CsrGraph<T>::getInfo(int v) const {
+    return info[v];
+}
+
+///@return distance of v found by the last unweightedShortestPath, dijkstraShortestPath or longestPath
+template <class T>
+int CsrGraph<T>::getDist(int v) const {
+    return dist[v];
+}
+
+///@return width of the widest path to v found by the last widestPath
+template <class T>
+int CsrGraph<T>::getCap(int v) const {
+    return cap[v];
+}
+
+template <class T>
+int CsrGraph<T>::getFlux(int e) const {
+    return flux[e];
+}
+
+template <class T>
+int CsrGraph<T>::edgesBegin(int v) const {
+    return offset[v];
+}
+
+template <class T>
+int CsrGraph<T>::edgesEnd(int v) const {
+    return offset[v + 1];
+}
+
+template <class T>
+int CsrGraph<T>::getDest(int e) const {
+    return dest[e];
+}
+
+template <class T>
+int CsrGraph<T>::getCapacity(int e) const {
+    return capacity[e];
+}
+
+template <class T>
+int CsrGraph<T>::getDuration(int e) const {
+    return duration[e];
+}
+
+///Sets flux of every edge to zero
+template <class T>
+void CsrGraph<T>::zeroFlux() {
+    std::fill(flux.begin(), flux.end(), 0);
+}
+
+///Copies the flux of every edge from graph, which must have the edges this CSR graph was built from
+///\param graph the graph passed to the constructor, unchanged in structure since it was frozen
+template <class T>
+void CsrGraph<T>::readFlux(const Graph<T> &graph) {
+    for (int v = 0; v < getNumVertex(); v++) {
+        int e = offset[v];
+        for (const Edge<T> &edge : graph.vertexSet[v]->adj) flux[e++] = edge.flux;
+    }
+}
+
+///Copies the flux of every edge back into the graph this one was frozen from,
+///so algorithms on the pointer-based graph (longestPath, vertexTime) see it
+///\param graph the graph passed to the constructor, unchanged in structure since it was frozen
+template <class T>
+void CsrGraph<T>::writeFlux(Graph<T> &graph) const {
+    for (int v = 0; v < getNumVertex(); v++) {
+        int e = offset[v];
+        for (Edge<T> &edge : graph.vertexSet[v]->adj) edge.flux = flux[e++];
+    }
+}
+
+///Breadth-first search from s, counting edges as distance, like Graph::unweightedShortestPath
+///\param s index of the start vertex
+template <class T>
+void CsrGraph<T>::unweightedShortestPath(int s) {
+    std::fill(dist.begin(), dist.end(), INFTY);
+    std::fill(pred.begin(), pred.end(), -1);
+    order.clear();
+    dist[s] = 0;
+    order.push_back(s);
+    for (size_t head = 0; head < order.size(); head++) {
+        int v = order[head];
+        for (int e = offset[v]; e < offset[v + 1]; e++) {
+            int w = dest[e];
+            if (dist[w] == INFTY) {
+                dist[w] = dist[v] + 1;
+                pred[w] = e;
+                order.push_back(w);
+            }
+        }
+    }
+}
+
+///Dijkstra's algorithm from s, using edge duration as weight, with Graph::dijkstraShortestPath's choice among
+///predecessors giving the same distance over a positive duration: the one with the smallest index
+///\param s index of the start vertex
+template <class T>
+void CsrGraph<T>::dijkstraShortestPath(int s) {
+    std::fill(dist.begin(), dist.end(), INFTY);
+    std::fill(pred.begin(), pred.end(), -1);
+    heap.reset(getNumVertex());
+    dist[s] = 0;
+    heap.insert(s, 0);
+    while (heap.getSize() > 0) {
+        int v = heap.removeMin(), d = dist[v];
+        for (int e = offset[v], end = offset[v + 1]; e < end; e++) {
+            int w = dest[e];
+            if (d + duration[e] < dist[w]) {
+                dist[w] = d + duration[e];
+                pred[w] = e;
+                if (heap.hasKey(w)) heap.decreaseKey(w, dist[w]);
+                else heap.insert(w, dist[w]);
+            } else if (d + duration[e] == dist[w] && duration[e] > 0 && v < source[pred[w]]) {
+                pred[w] = e;
+            }
+        }
+    }
+}
+
+///Maximum capacity (widest) path from s, with the same width and path as Graph::firstAlgorithm: equally wide
+///vertices leave the heap in the order they got their width
+///\param s index of the start vertex
+///\param t index of the target vertex
+///@return the capacity of the widest path from s to t, 0 if t can't be reached
+template <class T>
+int CsrGraph<T>::widestPath(int s, int t) {
+    std::fill(cap.begin(), cap.end(), 0);
+    std::fill(pred.begin(), pred.end(), -1);
+    widthHeap.reset(getNumVertex());
+    int widened = 0;
+    cap[s] = INFTY;
+    widthHeap.insert(s, {-INFTY, widened++});
+    while (widthHeap.getSize() > 0) {
+        int v = widthHeap.removeMin(), c = cap[v];
+        for (int e = offset[v], end = offset[v + 1]; e < end; e++) {
+            int w = dest[e];
+            int through = std::min(c, capacity[e]);
+            if (through > cap[w]) {
+                cap[w] = through;
+                pred[w] = e;
+                if (widthHeap.hasKey(w)) widthHeap.decreaseKey(w, {-through, widened++});
+                else widthHeap.insert(w, {-through, widened++});
+            }
+        }
+    }
+    return s != t && pred[t] == -1 ? 0 : cap[t];
+}
+
+///Edmonds-Karp maximum flow from s to t on the implicit residual graph:
+///edge e has residual capacity capacity[e] - flux[e] forwards and flux[e] backwards
+///Fills flux, and paths with its decomposition, like Graph::edmondKarpFlux
+///\param s index of the start vertex
+///\param t index of the target vertex
+///@return the maximum flow, 0 if s is t
+template <class T>
+int CsrGraph<T>::edmondKarpFlux(int s, int t) {
+    zeroFlux();
+    if (s == t) {
+        // the search would find the empty path, and augment it for ever
+        paths.clear();
+        return 0;
+    }
+    int total = 0;
+    while (true) {
+        std::fill(pred.begin(), pred.end(), -1);
+        order.clear();
+        order.push_back(s);
+        pred[s] = -2;
+        for (size_t head = 0; head < order.size() && pred[t] == -1; head++) {
+            int v = order[head];
+            for (int e = offset[v]; e < offset[v + 1]; e++) {
+                if (pred[dest[e]] == -1 && capacity[e] - flux[e] > 0) {
+                    pred[dest[e]] = e;
+                    order.push_back(dest[e]);
+                }
+            }
+            for (int i = inOffset[v]; i < inOffset[v + 1]; i++) {
+                int e = inEdge[i];
+                if (pred[source[e]] == -1 && flux[e] > 0) {
+                    pred[source[e]] = ~e;
+                    order.push_back(source[e]);
+                }
+            }
+        }
+        if (pred[t] == -1) break;
+
+        int resCap = INFTY;
+        for (int v = t; v != s; v = arcTail(pred[v])) resCap = std::min(resCap, residual(pred[v]));
+        for (int v = t; v != s; v = arcTail(pred[v])) {
+            int e = pred[v];
+            if (e >= 0) flux[e] += resCap;
+            else flux[~e] -= resCap;
+        }
+        total += resCap;
+    }
+    std::fill(pred.begin(), pred.end(), -1);
+    decomposeFlux(s, t);
+    return total;
+}
+
+///@return number of residual arcs leaving v: its outgoing edges, then the reverses of its incoming edges
+template <class T>
+int CsrGraph<T>::arcCount(int v) const {
+    return offset[v + 1] - offset[v] + inOffset[v + 1] - inOffset[v];
+}
+
+///@return the i-th residual arc leaving v: e for edge e, ~e for the reverse of edge e
+template <class T>
+int CsrGraph<T>::arcAt(int v, int i) const {
+    int out = offset[v + 1] - offset[v];
+    return i < out ? offset[v] + i : ~inEdge[inOffset[v] + i - out];
+}
+
+///@return residual capacity of an arc
+template <class T>
+int CsrGraph<T>::residual(int arc) const {
+    return arc >= 0 ? capacity[arc] - flux[arc] : flux[~arc];
+}
+
+///@return the vertex an arc points to
+template <class T>
+int CsrGraph<T>::arcHead(int arc) const {
+    return arc >= 0 ? dest[arc] : source[~arc];
+}
+
+///@return the vertex an arc leaves from
+template <class T>
+int CsrGraph<T>::arcTail(int arc) const {
+    return arc >= 0 ? source[arc] : dest[~arc];
+}
+
+///Dinic phase start: BFS over the residual arcs, storing each vertex's level in dist
+///\param s index of the start vertex
+///\param t index of the target vertex
+///@return true if t is reachable from s in the residual graph
+template <class T>
+bool CsrGraph<T>::buildLevelGraph(int s, int t) {
+    std::fill(dist.begin(), dist.end(), -1);
+    order.clear();
+    dist[s] = 0;
+    order.push_back(s);
+    for (size_t head = 0; head < order.size(); head++) {
+        int v = order[head];
+        for (int i = 0; i < arcCount(v); i++) {
+            int arc = arcAt(v, i), w = arcHead(arc);
+            if (dist[w] == -1 && residual(arc) > 0) {
+                dist[w] = dist[v] + 1;
+                order.push_back(w);
+            }
+        }
+    }
+    return dist[t] != -1;
+}
+
+///Dinic's maximum flow from s to t: each phase builds the BFS level graph of the residual network once and then
+///saturates it with a blocking flow, found by depth-first searches that never retry an arc that led nowhere
+///Fills flux, and paths with its decomposition, like Graph::edmondKarpFlux
+///\param s index of the start vertex
+///\param t index of the target vertex
+///@return the maximum flow, 0 if s is t
+template <class T>
+int CsrGraph<T>::dinicFlux(int s, int t) {
+    zeroFlux();
+    if (s == t) {
+        // nothing flows from a vertex to itself, and the blocking flow needs at least one arc to reach t
+        paths.clear();
+        return 0;
+    }
+    int total = 0;
+    while (buildLevelGraph(s, t)) {
+        std::fill(current.begin(), current.end(), 0);
+        arcStack.clear();
+        int v = s;
+        while (true) {
+            if (v == t) {
+                int resCap = INFTY;
+                for (int arc : arcStack) resCap = std::min(resCap, residual(arc));
+                for (int arc : arcStack) {
+                    if (arc >= 0) flux[arc] += resCap;
+                    else flux[~arc] -= resCap;
+                }
+                total += resCap;
+                // resume from the tail of the first saturated arc
+                size_t k = 0;
+                while (residual(arcStack[k]) > 0) k++;
+                v = arcTail(arcStack[k]);
+                arcStack.resize(k);
+                continue;
+            }
+            bool advanced = false;
+            for (; current[v] < arcCount(v); current[v]++) {
+                int arc = arcAt(v, current[v]), w = arcHead(arc);
+                if (dist[w] == dist[v] + 1 && residual(arc) > 0) {
+                    arcStack.push_back(arc);
+                    v = w;
+                    advanced = true;
+                    break;
+                }
+            }
+            if (advanced) continue;
+            // dead end: drop v from the level graph and retreat
+            dist[v] = -1;
+            if (arcStack.empty()) break;
+            v = arcTail(arcStack.back());
+            arcStack.pop_back();
+            current[v]++;
+        }
+    }
+    decomposeFlux(s, t);
+    return total;
+}
+
+///Push-relabel: sets every label to the exact residual distance to sink (n if sink can't be reached) and
+///rebuilds the active buckets from scratch
+///\param sink vertex the excess is being moved to
+///\param source vertex the excess came from, kept at label n
+template <class T>
+void CsrGraph<T>::globalRelabel(int sink, int source) {
+    int n = getNumVertex();
+    std::fill(dist.begin(), dist.end(), n);
+    std::fill(labelCount.begin(), labelCount.end(), 0);
+    order.clear();
+    dist[sink] = 0;
+    order.push_back(sink);
+    for (size_t head = 0; head < order.size(); head++) {
+        int v = order[head];
+        for (int i = 0; i < arcCount(v); i++) {
+            int arc = arcAt(v, i), w = arcHead(arc);
+            // w reaches v through the reverse of arc
+            if (dist[w] == n && w != source && residual(~arc) > 0) {
+                dist[w] = dist[v] + 1;
+                order.push_back(w);
+            }
+        }
+    }
+    std::fill(bucketHead.begin(), bucketHead.end(), -1);
+    std::fill(inBucket.begin(), inBucket.end(), 0);
+    std::fill(current.begin(), current.end(), 0);
+    for (int v = 0; v < n; v++) {
+        labelCount[dist[v]]++;
+        activate(v, sink, source);
+    }
+}
+
+///Push-relabel: queues v in the bucket of its label if it has excess it can still move
+template <class T>
+void CsrGraph<T>::activate(int v, int sink, int source) {
+    if (excess[v] > 0 && v != sink && v != source && dist[v] < getNumVertex() && !inBucket[v]) {
+        inBucket[v] = 1;
+        bucketNext[v] = bucketHead[dist[v]];
+        bucketHead[dist[v]] = v;
+    }
+}
+
+///Highest-label push-relabel, moving all the excess it can to sink
+///Labels (in dist) are exact distances after every global relabel, which runs again once n relabels have happened;
+///when no vertex is left with some label k < n, every vertex above k is cut off from sink and lifted to n (gap heuristic)
+///\param sink vertex the excess is moved to
+///\param source vertex the excess came from
+template <class T>
+void CsrGraph<T>::pushRelabelPhase(int sink, int source) {
+    int n = getNumVertex();
+    globalRelabel(sink, source);
+    int highest = n - 1, relabels = 0;
+    while (true) {
+        while (highest >= 0 && bucketHead[highest] == -1) highest--;
+        if (highest < 0) break;
+        int v = bucketHead[highest];
+        bucketHead[highest] = bucketNext[v];
+        inBucket[v] = 0;
+        if (dist[v] != highest) continue; // lifted by a gap since it was queued
+
+        // discharge v
+        while (excess[v] > 0) {
+            if (current[v] == arcCount(v)) {
+                // relabel
+                int old = dist[v], label = n;
+                for (int i = 0; i < arcCount(v); i++) {
+                    int arc = arcAt(v, i);
+                    if (residual(arc) > 0) label = std::min(label, dist[arcHead(arc)] + 1);
+                }
+                labelCount[old]--;
+                dist[v] = std::min(label, n);
+                labelCount[dist[v]]++;
+                current[v] = 0;
+                relabels++;
+                if (labelCount[old] == 0 && old < n) {
+                    // gap: nothing left at label old, so nothing above it reaches sink
+                    for (int u = 0; u < n; u++) {
+                        if (dist[u] > old && dist[u] < n) {
+                            labelCount[dist[u]]--;
+                            dist[u] = n;
+                            labelCount[n]++;
+                        }
+                    }
+                }
+                if (dist[v] >= n) break;
+                continue;
+            }
+            int arc = arcAt(v, current[v]), w = arcHead(arc);
+            int r = residual(arc);
+            if (r > 0 && dist[v] == dist[w] + 1) {
+                int d = std::min(excess[v], r);
+                if (arc >= 0) flux[arc] += d;
+                else flux[~arc] -= d;
+                excess[v] -= d;
+                excess[w] += d;
+                activate(w, sink, source);
+                if (dist[w] > highest && inBucket[w]) highest = dist[w];
+            } else {
+                current[v]++;
+            }
+        }
+        if (relabels >= n) {
+            globalRelabel(sink, source);
+            relabels = 0;
+            highest = n - 1;
+        } else if (excess[v] > 0) {
+            activate(v, sink, source);
+            if (dist[v] < n && dist[v] > highest) highest = dist[v];
+        }
+    }
+}
+
+///Highest-label push-relabel maximum flow from s to t, with global relabeling and the gap heuristic
+///The first phase moves as much flow as possible to t; the second returns the excess stuck in vertices cut off
+///from t to s, so flux ends up a valid flow. Fills paths with a decomposition of that flow.
+///\param s index of the start vertex
+///\param t index of the target vertex
+///@return the maximum flow, 0 if s is t
+template <class T>
+int CsrGraph<T>::pushRelabelFlux(int s, int t) {
+    int n = getNumVertex();
+    zeroFlux();
+    if (s == t) {
+        // s would be both the source and the sink of a phase, and its neighbours would never stop discharging
+        paths.clear();
+        return 0;
+    }
+    excess.assign(n, 0);
+    labelCount.assign(n + 1, 0);
+    bucketHead.assign(n + 1, -1);
+    bucketNext.assign(n, -1);
+    inBucket.assign(n, 0);
+    for (int e = offset[s]; e < offset[s + 1]; e++) {
+        flux[e] = capacity[e];
+        excess[dest[e]] += capacity[e];
+        excess[s] -= capacity[e];
+    }
+    pushRelabelPhase(t, s);
+    pushRelabelPhase(s, t);
+    decomposeFlux(s, t);
+    return excess[t];
+}
+
+///Removes the flow cycles from flux, then sets paths to a decomposition of the flux from s to t, with the
+///amount each path carries. Unlike the augmenting paths of an engine, these only follow edges forwards and add
+///up to exactly the flux of every edge, whichever engine produced it.
+///A depth-first search over the edges carrying flux meets every cycle as an edge back to a vertex on its stack and
+///cancels it by its smallest flux, which empties at least one edge; a vertex whose edges are all explored can't be
+///on a cycle any more. The acyclic rest is peeled into paths by walking from s, each walk emptying at least one
+///edge. So there are at most E cycles and E paths, found in O(E * L) for cycles and paths of at most L edges.
+///\param s index of the start vertex
+///\param t index of the target vertex
+///@return true if a cycle was cancelled, which changed flux but not the value of the flow; false with no paths if
+///s is t
+template <class T>
+bool CsrGraph<T>::decomposeFlux(int s, int t) {
+    if (s == t) {
+        // no flow leaves s for itself, and the walks from s would stop at t before taking any edge
+        paths.clear();
+        return false;
+    }
+    int n = getNumVertex();
+    bool cancelled = false;
+    std::vector<int> state(n, -1);   // position on the DFS stack, -1 if off it, -2 once it can't be on a cycle
+    std::fill(current.begin(), current.end(), 0);
+    for (int root = 0; root < n; root++) {
+        if (state[root] != -1) continue;
+        order.assign(1, root);   // the DFS stack
+        arcStack.clear();        // arcStack[i] goes from order[i] to order[i + 1]
+        state[root] = 0;
+        while (!order.empty()) {
+            int v = order.back();
+            int &e = current[v];
+            while (offset[v] + e < offset[v + 1] && (flux[offset[v] + e] == 0 || state[dest[offset[v] + e]] == -2)) e++;
+            if (offset[v] + e == offset[v + 1]) {
+                state[v] = -2;
+                order.pop_back();
+                if (!arcStack.empty()) arcStack.pop_back();
+                continue;
+            }
+            int edge = offset[v] + e, w = dest[edge];
+            if (state[w] == -1) {
+                state[w] = order.size();
+                order.push_back(w);
+                arcStack.push_back(edge);
+                continue;
+            }
+            // edge closes the cycle order[state[w]] -> ... -> v -> w
+            int amount = flux[edge];
+            for (size_t i = state[w]; i < arcStack.size(); i++) amount = std::min(amount, flux[arcStack[i]]);
+            flux[edge] -= amount;
+            for (size_t i = state[w]; i < arcStack.size(); i++) flux[arcStack[i]] -= amount;
+            cancelled = true;
+            // back to w; the vertices above it are explored again from the edges they stopped at
+            while ((int) order.size() > state[w] + 1) {
+                state[order.back()] = -1;
+                order.pop_back();
+                arcStack.pop_back();
+            }
+        }
+    }
+
+    paths.clear();
+    std::vector<int> rest(flux);
+    std::fill(current.begin(), current.end(), 0);
+    while (true) {
+        arcStack.clear();
+        int v = s;
+        while (v != t) {
+            int &e = current[v];
+            while (offset[v] + e < offset[v + 1] && rest[offset[v] + e] == 0) e++;
+            if (offset[v] + e == offset[v + 1]) break;
+            arcStack.push_back(offset[v] + e);
+            v = dest[offset[v] + e];
+        }
+        if (v != t) break;
+        int amount = INFTY;
+        for (int e : arcStack) amount = std::min(amount, rest[e]);
+        paths.push(info[s]);
+        for (int e : arcStack) {
+            rest[e] -= amount;
+            paths.push(info[dest[e]]);
+        }
+        paths.commit(amount);
+    }
+    return cancelled;
+}
+
+///Kahn's algorithm over the edges that carry flux
+///Uses cap as in-degree scratch, so it overwrites the result of the last widestPath
+///@return the vertices in topological order of the flux subgraph (only its acyclic part if the flux has cycles)
+template <class T>
+const std::vector<int> &CsrGraph<T>::fluxTopologicalOrder() {
+    int n = getNumVertex();
+    std::fill(cap.begin(), cap.end(), 0); // in-degree
+    for (int e = 0; e < getNumEdges(); e++)
+        if (flux[e] != 0) cap[dest[e]]++;
+    order.clear();
+    for (int v = 0; v < n; v++)
+        if (cap[v] == 0) order.push_back(v);
+    for (size_t head = 0; head < order.size(); head++) {
+        int v = order[head];
+        for (int e = offset[v]; e < offset[v + 1]; e++)
+            if (flux[e] != 0 && --cap[dest[e]] == 0) order.push_back(dest[e]);
+    }
+    return order;
+}
+
+///Longest path, in duration, from s to t over the edges that carry flux, like Graph::longestPath: the soonest the
+///whole group can meet at t, the forward pass of the critical path analysis
+///\param s index of the start vertex
+///\param t index of the target vertex
+///@return the longest duration from s to t, NINFTY if t can't be reached
+template <class T>
+int CsrGraph<T>::longestPath(int s, int t) {
+    const std::vector<int> &topo = fluxTopologicalOrder();
+    std::fill(dist.begin(), dist.end(), NINFTY);
+    std::fill(pred.begin(), pred.end(), -1);
+    dist[s] = 0;
+    for (int v : topo) {
+        if (dist[v] == NINFTY) continue;
+        for (int e = offset[v]; e < offset[v + 1]; e++) {
+            if (flux[e] != 0 && dist[dest[e]] < dist[v] + duration[e]) {
+                dist[dest[e]] = dist[v] + duration[e];
+                pred[dest[e]] = e;
+            }
+        }
+    }
+    return dist[t];
+}
+
+///Steps back from t through the edges recorded by the last unweightedShortestPath, dijkstraShortestPath,
+///widestPath or longestPath
+///\param s index of the start vertex
+///\param t index of the target vertex
+///@return contents of the vertices in the path, in order, or an empty vector if t wasn't reached
+template <class T>
+std::vector<T> CsrGraph<T>::getPath(int s, int t) const {
+    std::vector<T> res;
+    if (s != t && pred[t] < 0) return res;
+    for (int v = t; v != s; v = source[pred[v]]) res.push_back(info[v]);
+    res.push_back(info[s]);
+    std::reverse(res.begin(), res.end());
+    return res;
+}
+
+#endif /* CSRGRAPH_H_ */
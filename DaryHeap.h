@@ -0,0 +1,140 @@
+///\file
+/// Indexed d-ary min-heap over dense integer keys, such as vertex positions
+
+#ifndef DARYHEAP_H_
+#define DARYHEAP_H_
+
+#include <vector>
+
+/************************* DaryHeap  **************************/
+
+///Min-heap of (key, value) pairs whose keys are the integers 0..n-1.
+///Positions live in a plain array indexed by key, so hasKey and decreaseKey are a single load and moving an
+///element costs one store. With D children per node the tree is log_D(n) deep: sift-ups (decreaseKey) get cheaper
+///as D grows, sift-downs (removeMin) compare D children per level.
+///\tparam V type of the values (priorities), compared with <
+///\tparam D number of children per node, at least 2
+template <class V, int D = 4>
+class DaryHeap {
+    static_assert(D >= 2, "a heap node needs at least two children");
+
+    struct Node {
+        int key;
+        V value;
+    };
+
+    std::vector<Node> a;    // the heap, root at 0, children of i at D*i+1 .. D*i+D
+    std::vector<int> pos;   // position of each key in a, -1 if it isn't in the heap
+
+    void upHeap(int i);
+    void downHeap(int i);
+
+public:
+    explicit DaryHeap(int n = 0);
+    void reset(int n);
+    int getSize() const;
+    bool hasKey(int key) const;
+    void insert(int key, const V &value);
+    void decreaseKey(int key, const V &value);
+    int removeMin();
+};
+
+///Creates an empty heap for the keys 0..n-1
+template <class V, int D>
+DaryHeap<V, D>::DaryHeap(int n) : pos(n, -1) {
+    a.reserve(n);
+}
+
+///Empties the heap and makes it hold the keys 0..n-1, reusing its memory
+template <class V, int D>
+void DaryHeap<V, D>::reset(int n) {
+    a.clear();
+    a.reserve(n);
+    pos.assign(n, -1);
+}
+
+///@return number of elements in the heap
+template <class V, int D>
+int DaryHeap<V, D>::getSize() const {
+    return a.size();
+}
+
+///@return true if key is in the heap
+template <class V, int D>
+bool DaryHeap<V, D>::hasKey(int key) const {
+    return pos[key] != -1;
+}
+
+///Moves the element at i up while it's smaller than its parent, shifting the parents down behind it
+template <class V, int D>
+void DaryHeap<V, D>::upHeap(int i) {
+    Node node = a[i];
+    while (i > 0) {
+        int parent = (i - 1) / D;
+        if (!(node.value < a[parent].value)) break;
+        a[i] = a[parent];
+        pos[a[i].key] = i;
+        i = parent;
+    }
+    a[i] = node;
+    pos[node.key] = i;
+}
+
+///Moves the element at i down while one of its children is smaller, shifting that child up in its place
+template <class V, int D>
+void DaryHeap<V, D>::downHeap(int i) {
+    Node node = a[i];
+    int size = a.size();
+    while (true) {
+        int first = D * i + 1;
+        if (first >= size) break;
+        int last = first + D < size ? first + D : size;
+        int j = first;
+        for (int c = first + 1; c < last; c++) {
+            if (a[c].value < a[j].value) j = c;
+        }
+        if (!(a[j].value < node.value)) break;
+        a[i] = a[j];
+        pos[a[i].key] = i;
+        i = j;
+    }
+    a[i] = node;
+    pos[node.key] = i;
+}
+
+///Inserts (key, value), unless key is already in the heap
+template <class V, int D>
+void DaryHeap<V, D>::insert(int key, const V &value) {
+    if (hasKey(key)) return;
+    a.push_back({key, value});
+    upHeap(a.size() - 1);
+}
+
+///Lowers the value of key, unless key isn't in the heap or value is bigger
+template <class V, int D>
+void DaryHeap<V, D>::decreaseKey(int key, const V &value) {
+    if (!hasKey(key)) return;
+    int i = pos[key];
+    if (a[i].value < value) return;
+    a[i].value = value;
+    upHeap(i);
+}
+
+///Removes the element with the smallest value
+///@return its key, -1 if the heap is empty
+template <class V, int D>
+int DaryHeap<V, D>::removeMin() {
+    if (a.empty()) return -1;
+    int min = a[0].key;
+    pos[min] = -1;
+    if (a.size() > 1) {
+        a[0] = a.back();
+        a.pop_back();
+        downHeap(0);
+    } else {
+        a.pop_back();
+    }
+    return min;
+}
+
+#endif /* DARYHEAP_H_ */
@@ -0,0 +1,136 @@
+///\file
+/// Priority queue policies for Graph::dijkstraShortestPath
+///
+/// Every policy is default constructible, kept between queries by its owner and offers
+///   void reset(int n, int maxWeight)  empties the queue for keys 0..n-1 and edge weights in 0..maxWeight,
+///                                     reusing the memory of earlier queries
+///   bool empty() const
+///   void push(int key, int priority)  key is new or its priority went down
+///   int pop()                         a key with the smallest priority
+/// Dijkstra only pushes priorities that are at least the last one popped, which the bucket policies rely on.
+/// They don't remove outdated entries, so pop may return a key again; the caller skips keys it already settled.
+
+#ifndef DIJKSTRAQUEUES_H_
+#define DIJKSTRAQUEUES_H_
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "DaryHeap.h"
+
+/************************* HeapQueue  **************************/
+
+///Indexed heap with decrease-key: every key is in the queue at most once. O(log n) per operation, any weights.
+class HeapQueue {
+    DaryHeap<int> heap;
+
+public:
+    void reset(int n, int /*maxWeight*/) {
+        heap.reset(n);
+    }
+
+    bool empty() const {
+        return heap.getSize() == 0;
+    }
+
+    void push(int key, int priority) {
+        if (heap.hasKey(key)) heap.decreaseKey(key, priority);
+        else heap.insert(key, priority);
+    }
+
+    int pop() {
+        return heap.removeMin();
+    }
+};
+
+/************************* DialQueue  **************************/
+
+///Dial's buckets: maxWeight + 1 buckets used circularly, since every pending priority lies within maxWeight of
+///the last one popped. O(1) per push and O(maxWeight) amortised scanning per distinct distance, so it suits small
+///integer weights.
+class DialQueue {
+    std::vector<std::vector<int>> buckets;
+    int current = 0;     // bucket of the last priority popped
+    size_t count = 0;
+
+public:
+    void reset(int /*n*/, int maxWeight) {
+        // more buckets than maxWeight + 1 work just as well, so they are only ever added
+        if (buckets.size() < (size_t) maxWeight + 1) buckets.resize(maxWeight + 1);
+        for (std::vector<int> &bucket : buckets) bucket.clear();
+        current = 0;
+        count = 0;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    void push(int key, int priority) {
+        buckets[priority % buckets.size()].push_back(key);
+        count++;
+    }
+
+    int pop() {
+        while (buckets[current].empty()) current = (current + 1) % buckets.size();
+        int key = buckets[current].back();
+        buckets[current].pop_back();
+        count--;
+        return key;
+    }
+};
+
+/************************* RadixHeapQueue  **************************/
+
+///Radix heap: entries are bucketed by the highest bit in which their priority differs from the last one popped.
+///Emptying bucket 0 refills it from the lowest non-empty bucket, whose entries then spread over lower buckets,
+///so each entry moves at most 32 times. O(log C) amortised per entry, for weights of any size.
+class RadixHeapQueue {
+    std::vector<std::pair<unsigned, int>> buckets[33]; // (priority, key)
+    unsigned last = 0;   // last priority popped
+    size_t count = 0;
+
+    static int bucketOf(unsigned priority, unsigned last) {
+        unsigned diff = priority ^ last;
+#if defined(__GNUC__) || defined(__clang__)
+        return diff == 0 ? 0 : 32 - __builtin_clz(diff);
+#else
+        int width = 0;
+        for (; diff != 0; diff >>= 1) width++;
+        return width;
+#endif
+    }
+
+public:
+    void reset(int /*n*/, int /*maxWeight*/) {
+        for (std::vector<std::pair<unsigned, int>> &bucket : buckets) bucket.clear();
+        last = 0;
+        count = 0;
+    }
+
+    bool empty() const {
+        return count == 0;
+    }
+
+    void push(int key, int priority) {
+        buckets[bucketOf(priority, last)].emplace_back(priority, key);
+        count++;
+    }
+
+    int pop() {
+        if (buckets[0].empty()) {
+            int i = 1;
+            while (buckets[i].empty()) i++;
+            last = buckets[i][0].first;
+            for (const std::pair<unsigned, int> &entry : buckets[i]) last = std::min(last, entry.first);
+            for (const std::pair<unsigned, int> &entry : buckets[i]) buckets[bucketOf(entry.first, last)].push_back(entry);
+            buckets[i].clear();
+        }
+        int key = buckets[0].back().second;
+        buckets[0].pop_back();
+        count--;
+        return key;
+    }
+};
+
+#endif /* DIJKSTRAQUEUES_H_ */
@@ -0,0 +1,187 @@
+///\file
+/// Incremental maximum flow between a fixed pair of vertices, kept alive across calls
+
+#ifndef FLOWSESSION_H_
+#define FLOWSESSION_H_
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+template <class T> class Vertex;
+template <class T> class Edge;
+template <class T> class Graph;
+
+/************************* FlowSession  **************************/
+
+///Flow state between an origin and a target that survives between requests to raise the flow.
+///The residual grid is the graph itself (edge flux plus Vertex::incoming); the session adds the flow value and
+///Dinic's level graph with its current-arc pointers. A level graph stays valid while only the session changes
+///the flux, so a request picks the blocking flow up where the previous one stopped and only rebuilds the levels
+///once it is exhausted. Whoever else rewrites the flux must close the session.
+///The session keeps vertex positions rather than pointers, so the graph owning it can still be copied.
+template <class T>
+class FlowSession {
+    bool opened = false;
+    bool levelsValid = false;
+    int s = 0, t = 0;            // positions of origin and target in the graph's vertexSet
+    int flow = 0;
+    std::vector<int> level;      // BFS level in the residual grid, -1 if unreachable or a dead end
+    std::vector<int> current;    // next arc to try: adj[i], or incoming[i - adj.size()] reversed
+    std::vector<std::pair<int, int>> arcStack; // (tail, arc at tail) of the partial path being built
+    std::vector<int> queue;
+
+    int residual(const Graph<T> &graph, int v, int arc) const;
+    int arcHead(const Graph<T> &graph, int v, int arc) const;
+    void pushFlow(Graph<T> &graph, int v, int arc, int amount) const;
+    bool buildLevels(const Graph<T> &graph);
+
+public:
+    bool isOpenFor(int s, int t) const;
+    void open(const Graph<T> &graph, int s, int t);
+    void close();
+    int getFlow() const;
+    int increase(Graph<T> &graph, int amount);
+};
+
+///@return true if the session holds the flow from s to t
+template <class T>
+bool FlowSession<T>::isOpenFor(int s, int t) const {
+    return opened && this->s == s && this->t == t;
+}
+
+///Starts a session on the flux currently stored in the graph
+///\param graph graph whose flux is taken as the starting flow
+///\param s position of the origin
+///\param t position of the target
+template <class T>
+void FlowSession<T>::open(const Graph<T> &graph, int s, int t) {
+    this->s = s;
+    this->t = t;
+    int n = graph.vertexSet.size();
+    level.assign(n, -1);
+    current.assign(n, 0);
+    flow = 0;
+    arcStack.clear();
+    const Vertex<T> *origin = graph.vertexSet[s];
+    for (const Edge<T> &edge : origin->adj) flow += edge.flux;
+    for (const std::pair<int, int> &in : origin->incoming) flow -= graph.vertexSet[in.first]->adj[in.second].flux;
+    opened = true;
+    levelsValid = false;
+}
+
+///Forgets the session; the next request starts over from the graph's flux
+template <class T>
+void FlowSession<T>::close() {
+    opened = false;
+    levelsValid = false;
+}
+
+///@return value of the flow held by the session
+template <class T>
+int FlowSession<T>::getFlow() const {
+    return flow;
+}
+
+template <class T>
+int FlowSession<T>::residual(const Graph<T> &graph, int v, int arc) const {
+    const Vertex<T> *vertex = graph.vertexSet[v];
+    int out = vertex->adj.size();
+    if (arc < out) return vertex->adj[arc].capacity - vertex->adj[arc].flux;
+    const std::pair<int, int> &in = vertex->incoming[arc - out];
+    return graph.vertexSet[in.first]->adj[in.second].flux;
+}
+
+template <class T>
+int FlowSession<T>::arcHead(const Graph<T> &graph, int v, int arc) const {
+    const Vertex<T> *vertex = graph.vertexSet[v];
+    int out = vertex->adj.size();
+    return arc < out ? vertex->adj[arc].dest->idx : vertex->incoming[arc - out].first;
+}
+
+template <class T>
+void FlowSession<T>::pushFlow(Graph<T> &graph, int v, int arc, int amount) const {
+    Vertex<T> *vertex = graph.vertexSet[v];
+    int out = vertex->adj.size();
+    if (arc < out) vertex->adj[arc].flux += amount;
+    else graph.vertexSet[vertex->incoming[arc - out].first]->adj[vertex->incoming[arc - out].second].flux -= amount;
+}
+
+///Breadth-first search from s over the residual grid that rebuilds the levels and rewinds the current arcs
+///@return true if t can be reached
+template <class T>
+bool FlowSession<T>::buildLevels(const Graph<T> &graph) {
+    std::fill(level.begin(), level.end(), -1);
+    std::fill(current.begin(), current.end(), 0);
+    arcStack.clear();
+    queue.clear();
+    level[s] = 0;
+    queue.push_back(s);
+    for (size_t head = 0; head < queue.size() && level[t] == -1; head++) {
+        int v = queue[head];
+        const Vertex<T> *vertex = graph.vertexSet[v];
+        int arcs = vertex->adj.size() + vertex->incoming.size();
+        for (int arc = 0; arc < arcs; arc++) {
+            int w = arcHead(graph, v, arc);
+            if (level[w] == -1 && residual(graph, v, arc) > 0) {
+                level[w] = level[v] + 1;
+                queue.push_back(w);
+            }
+        }
+    }
+    levelsValid = level[t] != -1;
+    return levelsValid;
+}
+
+///Raises the flow by up to amount
+///\param graph graph the session was opened on
+///\param amount how much to add to the flow
+///@return how much was added, less than amount only if the flow became maximum
+template <class T>
+int FlowSession<T>::increase(Graph<T> &graph, int amount) {
+    int added = 0;
+    while (added < amount && (levelsValid || buildLevels(graph))) {
+        int v = arcStack.empty() ? s : arcHead(graph, arcStack.back().first, arcStack.back().second);
+        while (added < amount) {
+            if (v == t) {
+                int resCap = amount - added;
+                for (const std::pair<int, int> &arc : arcStack) resCap = std::min(resCap, residual(graph, arc.first, arc.second));
+                for (const std::pair<int, int> &arc : arcStack) pushFlow(graph, arc.first, arc.second, resCap);
+                added += resCap;
+                // resume from the tail of the first saturated arc, or stay at t if the limit was hit first
+                size_t k = 0;
+                while (k < arcStack.size() && residual(graph, arcStack[k].first, arcStack[k].second) > 0) k++;
+                if (k == arcStack.size()) break;
+                v = arcStack[k].first;
+                arcStack.resize(k);
+                continue;
+            }
+            const Vertex<T> *vertex = graph.vertexSet[v];
+            int arcs = vertex->adj.size() + vertex->incoming.size();
+            bool advanced = false;
+            for (; current[v] < arcs; current[v]++) {
+                int w = arcHead(graph, v, current[v]);
+                if (level[w] == level[v] + 1 && residual(graph, v, current[v]) > 0) {
+                    arcStack.emplace_back(v, current[v]);
+                    v = w;
+                    advanced = true;
+                    break;
+                }
+            }
+            if (advanced) continue;
+            // dead end: drop v from the level graph and retreat
+            level[v] = -1;
+            if (arcStack.empty()) {
+                levelsValid = false;
+                break;
+            }
+            v = arcStack.back().first;
+            arcStack.pop_back();
+            current[v]++;
+        }
+    }
+    flow += added;
+    return added;
+}
+
+#endif /* FLOWSESSION_H_ */
@@ -0,0 +1,139 @@
+///\file
+/// Blocked, multithreaded Floyd-Warshall all-pairs shortest paths on flat matrices
+
+#ifndef FLOYDWARSHALL_H_
+#define FLOYDWARSHALL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <vector>
+#include "ThreadPool.h"
+
+/************************* FloydWarshall  **************************/
+
+///All-pairs shortest paths of a graph with non-negative weights, kept as two row-major matrices in contiguous
+///arrays: distances and, for path reconstruction, the vertex before j on the shortest path from i to j.
+///The rows are padded to a multiple of TILE, so the matrices split into TILE x TILE tiles with no edge cases. Each
+///round k of the blocked algorithm relaxes the diagonal tile (k, k) first, then the other tiles of row and column k,
+///which only need the diagonal one, and then every remaining tile (i, j), which only needs (i, k) and (k, j). The
+///tiles of the last two phases are independent, so they are spread over a thread pool, and three tiles fit in the
+///L1 cache. The innermost loop is a branch-free min-plus over a tile row, which the compiler vectorizes.
+class FloydWarshall {
+public:
+    static constexpr int TILE = 64;
+    static constexpr int INFTY = std::numeric_limits<int>::max() / 2;  // so INFTY + INFTY doesn't overflow
+
+private:
+    int n = 0;                  // vertices
+    int stride = 0;             // length of a padded row, a multiple of TILE
+    std::vector<int> dist;      // [i * stride + j]: shortest distance from i to j, INFTY if there's no path
+    std::vector<int> pred;      // [i * stride + j]: vertex before j on that path, -1 if there's none
+
+    void relaxTile(int bi, int bj, int bk);
+
+public:
+    void reset(int n);
+    void addEdge(int i, int j, int weight);
+    void run(int threads);
+    int getNumVertex() const;
+    int getDist(int i, int j) const;
+    std::vector<int> getPath(int i, int j) const;
+};
+
+///Empties the matrices for n vertices and no edges, reusing their memory
+inline void FloydWarshall::reset(int n) {
+    this->n = n;
+    stride = (n + TILE - 1) / TILE * TILE;
+    dist.assign((size_t) stride * stride, INFTY);
+    pred.assign((size_t) stride * stride, -1);
+    for (int i = 0; i < n; i++) {
+        dist[(size_t) i * stride + i] = 0;
+        pred[(size_t) i * stride + i] = i;
+    }
+}
+
+///Adds an edge from i to j, keeping the lightest of parallel edges
+inline void FloydWarshall::addEdge(int i, int j, int weight) {
+    size_t ij = (size_t) i * stride + j;
+    if (weight < dist[ij]) {
+        dist[ij] = weight;
+        pred[ij] = i;
+    }
+}
+
+///Relaxes every path of tile (bi, bj) through the vertices of tile bk
+///\param bi tile row
+///\param bj tile column
+///\param bk tile of the intermediate vertices
+inline void FloydWarshall::relaxTile(int bi, int bj, int bk) {
+    for (int k = bk * TILE; k < (bk + 1) * TILE; k++) {
+        const int *__restrict dk = &dist[(size_t) k * stride + bj * TILE];
+        const int *__restrict pk = &pred[(size_t) k * stride + bj * TILE];
+        for (int i = bi * TILE; i < (bi + 1) * TILE; i++) {
+            int dik = dist[(size_t) i * stride + k];
+            // row k can't get shorter through k, and skipping it keeps the rows written apart from the rows read
+            if (dik == INFTY || i == k) continue;
+            int *__restrict di = &dist[(size_t) i * stride + bj * TILE];
+            int *__restrict pi = &pred[(size_t) i * stride + bj * TILE];
+            for (int j = 0; j < TILE; j++) {
+                int through = dik + dk[j], before = di[j];
+                // all ones where k gives a shorter path: a select with a mask, which compilers vectorize, not a branch
+                int shorter = -(int) (through < before);
+                pi[j] = (pk[j] & shorter) | (pi[j] & ~shorter);
+                di[j] = std::min(through, before);
+            }
+        }
+    }
+}
+
+///Computes every shortest path
+///\param threads number of threads relaxing tiles
+inline void FloydWarshall::run(int threads) {
+    int blocks = stride / TILE;
+    ThreadPool pool(std::max(1, std::min(threads, blocks)));
+    // runs task(0..count-1) on the pool, each index once, and waits for all of them
+    auto parallelFor = [&pool](int count, auto task) {
+        std::atomic<int> next{0};
+        pool.runOnAll([&](int) {
+            for (int t = next++; t < count; t = next++) task(t);
+        });
+    };
+    for (int bk = 0; bk < blocks; bk++) {
+        relaxTile(bk, bk, bk);
+        parallelFor(2 * blocks, [this, blocks, bk](int t) {
+            int b = t % blocks;
+            if (b == bk) return;
+            if (t < blocks) relaxTile(bk, b, bk);
+            else relaxTile(b, bk, bk);
+        });
+        parallelFor(blocks, [this, blocks, bk](int bi) {
+            if (bi == bk) return;
+            for (int bj = 0; bj < blocks; bj++) {
+                if (bj != bk) relaxTile(bi, bj, bk);
+            }
+        });
+    }
+}
+
+inline int FloydWarshall::getNumVertex() const {
+    return n;
+}
+
+///@return the shortest distance from i to j, INFTY if j can't be reached
+inline int FloydWarshall::getDist(int i, int j) const {
+    return dist[(size_t) i * stride + j];
+}
+
+///@return the vertices of the shortest path from i to j, in order, or an empty vector if j can't be reached
+inline std::vector<int> FloydWarshall::getPath(int i, int j) const {
+    std::vector<int> res;
+    if (getDist(i, j) == INFTY) return res;
+    const int *preds = &pred[(size_t) i * stride];
+    for (int v = j; v != i; v = preds[v]) res.push_back(v);
+    res.push_back(i);
+    std::reverse(res.begin(), res.end());
+    return res;
+}
+
+#endif /* FLOYDWARSHALL_H_ */
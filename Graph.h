@@ -12,17 +12,35 @@
 #include <queue>
 #include <limits>
 #include <algorithm>
-#include "MutablePriorityQueue.h"
 #include <set>
 #include <stack>
 #include <map>
-#include "minHeap.h"
+#include <unordered_map>
+#include <tuple>
+#include <utility>
+#include <chrono>
+#include <type_traits>
+#include "DaryHeap.h"
+#include "DijkstraQueues.h"
+#include "CsrGraph.h"
+#include "CriticalPath.h"
+#include "FloydWarshall.h"
+#include "FlowSession.h"
+#include "ParallelPushRelabel.h"
+#include "PathEnumerator.h"
+#include "PathStore.h"
+
+using namespace std;
 
 template <class T> class Edge;
 template <class T> class Graph;
 template <class T> class Vertex;
 
 #define INF std::numeric_limits<int>::max()
+// priority queue of dijkstraShortestPath: HeapQueue, DialQueue or RadixHeapQueue (see DijkstraQueues.h)
+#ifndef DIJKSTRA_QUEUE
+#define DIJKSTRA_QUEUE RadixHeapQueue
+#endif
 #define NINF std::numeric_limits<int>::min()
 
 /************************* Vertex  **************************/
@@ -34,7 +52,9 @@ class Vertex {
     bool visited;          // auxiliary field
     int dist = 0;
     Vertex<T> *path = nullptr;
-    int queueIndex = 0; 		// required by MutablePriorityQueue
+    int idx = 0;                // position in the graph's vertexSet
+    std::vector<std::pair<int, int>> incoming; // (source idx, position in its adj) of every edge arriving here
+    int pathEdge = 0;           // arc to this vertex from path: path's adj[pathEdge] or, if negative, adj[~pathEdge] reversed
 
     void addEdge(Vertex<T> *dest, int dur, int c, int w);
     int lt, et;
@@ -42,12 +62,13 @@ class Vertex {
 
 public:
     Vertex(T in);
-    bool operator<(Vertex<T> & vertex) const; // // required by MutablePriorityQueue
     T getInfo() const;
     int getDist() const;
     Vertex *getPath() const;
+    const std::vector<Edge<T>> &getAdj() const;
     friend class Graph<T>;
-    friend class MutablePriorityQueue<Vertex<T>>;
+    friend class CsrGraph<T>;
+    friend class FlowSession<T>;
 };
 
 
@@ -63,11 +84,6 @@ void Vertex<T>::addEdge(Vertex<T> *d, int dur, int c, int w) {
     adj.push_back(Edge<T>(d, dur, c, w));
 }
 
-template <class T>
-bool Vertex<T>::operator<(Vertex<T> & vertex) const {
-    return this->dist < vertex.dist;
-}
-
 template <class T>
 T Vertex<T>::getInfo() const {
     return this->info;
@@ -83,6 +99,12 @@ Vertex<T> *Vertex<T>::getPath() const {
     return this->path;
 }
 
+///@return the outgoing edges, without copying them
+template <class T>
+const std::vector<Edge<T>> &Vertex<T>::getAdj() const {
+    return this->adj;
+}
+
 /********************** Edge  ****************************/
 
 template <class T>
@@ -98,6 +120,7 @@ class Edge {
 public:
     int getWeight() const;
     void setWeight(int weight);
+    Vertex<T> *getDest() const;
     int getCapacity() const;
     void setCapacity(int capacity);
     int getFlux() const;
@@ -107,6 +130,8 @@ public:
     Edge(Vertex<T> *d, int duration, int c, int w);
     friend class Graph<T>;
     friend class Vertex<T>;
+    friend class CsrGraph<T>;
+    friend class FlowSession<T>;
     bool operator<(const Edge<T> & edge) const;
 };
 
@@ -119,28 +144,64 @@ Edge<T>::Edge(Vertex<T> *d, int duration, int c, int w): dest(d), weight(w), cap
 template <class T>
 class Graph {
 private:
-    int numberNodes, numberEdges;
+    int numberNodes = 0, numberEdges = 0;
     std::vector<Vertex<T> *> vertexSet;    // vertex set
     std::vector<Vertex<T> *> vertex;
+    std::vector<int> denseIdx;             // info -> position in vertexSet, for small non-negative integral ids
+    std::unordered_map<T, int> sparseIdx;  // info -> position in vertexSet, for every other id
+    friend class CsrGraph<T>;
+    friend class FlowSession<T>;
 
     //Fp05
     Vertex<T> * initSingleSource(const T &orig);
     bool relax(Vertex<T> *v, Vertex<T> *w, int weight);
-    int ** W = nullptr;   // dist
-    int **P = nullptr;   // path
+    FloydWarshall floydWarshall;          // all-pairs shortest durations, by position in vertexSet
     int findVertexIdx(const T &in) const;
+    std::vector<Vertex<T> *> bfsQueue;    // scratch queue of residualBfs
+    FlowSession<T> flowSession;           // flow kept between increaseGroupSize calls
+    int routedFrom = -1, routedTo = -1;   // positions of the ends of the group FindPathGivenGroupSize routed, -1 once
+                                          // another flow replaced it
+    int routedGroup = 0;                  // size of that group, raised by increaseGroupSize
+
+    std::vector<std::vector<Vertex<T> *>> widthBuckets; // scratch buckets of bucketWidestPath
+    std::tuple<HeapQueue, DialQueue, RadixHeapQueue> dijkstraQueues; // kept so queries reuse their memory
+    std::vector<Vertex<T> *> topoOrder;   // Kahn order of every vertex, cached; shorter than vertexSet on a cycle
+    bool topoValid = false;               // whether topoOrder matches the current edges
+    CsrGraph<T> fluxCsr;                  // frozen copy whose flux decomposeFlux refreshes and splits into paths
+    bool fluxCsrValid = false;            // whether fluxCsr has the current edges
+    std::vector<Vertex<T> *> fluxOrder;   // scratch Kahn order of the flux-carrying edges, for graphs with cycles
+    std::vector<int> inDegree;            // scratch of the Kahn passes
+
+    struct HopLabel {
+        int vertex;   // position in vertexSet
+        int width;    // bottleneck of the walk from the origin
+        int pred;     // position in the previous hop layer of the label it extends, -1 for the origin
+    };
+    std::vector<std::vector<HopLabel>> hopLayers; // scratch labels of the Pareto engine, one layer per hop count
+    std::vector<int> labelWidth;          // widest label of each vertex so far, in that engine
+    std::vector<int> labelPos;            // position of each vertex in the layer being built, -1 if it isn't
+
+    bool residualBfs(Vertex<T> *s, Vertex<T> *t, int minResidual = 1);
+    int augmentResidualPath(Vertex<T> *s, Vertex<T> *t, int limit);
+    void decomposeFlux(int s, int t);
+    void heapWidestPath(Vertex<T> *origin);
+    void kahn(std::vector<Vertex<T> *> &order, bool fluxOnly);
+    const std::vector<Vertex<T> *> &topologicalOrder();
+    const std::vector<Vertex<T> *> &fluxTopologicalOrder();
+    bool arrivalTimes(Vertex<T> *origin);
+    void bucketWidestPath(Vertex<T> *origin, int maxCapacity);
 
 public:
-    map<vector<T>, int> paths;
-    vector<T> mutatingPath;
-    ~Graph();
-    void printPath(std::map<vector<T>, T> printablePath); // prints a string meaning n subjects go through path
+    PathStore<T> paths;                   // paths found by the last algorithms, with their group sizes
+    void printPath(const PathStore<T> &printablePath); // prints a string meaning n subjects go through path
     Vertex<T> *findVertex(const T &in) const;
     bool addVertex(const T &in);
     bool addEdge(const T &sourc, const T &dest, int d, int c, int w);
+    void reserveVertices(int n);
+    bool reserveEdges(const T &in, int n);
     int getNumVertex() const;
-    std::vector<Vertex<T> *> getVertexSet() const;
-    void FindPathGivenGroupSize(T st, T ta, int groupSize);
+    const std::vector<Vertex<T> *> &getVertexSet() const;
+    int FindPathGivenGroupSize(T st, T ta, int groupSize, bool capacityScaling = false);
     int getNumberNodes() const;
     int getNumberEdges() const;
     int firstAlgorithm(T start, T end);
@@ -148,10 +209,11 @@ public:
     void setNumberNodes(int numberNodes);
     void setNumberEdges(int numberEdges);
     void paretoOptimalGroupSizeAndTransportShift(T origin, T target);
-    int recursivePathFinderLimited(T current, T target, int currentCap, int bfsCap, int maxCapEdges);
+    bool enumeratePaths(T origin, T target, const EnumerationLimits &limits, int threads);
+    bool allParetoOptimalPaths(T origin, T target, int threads, std::chrono::milliseconds timeLimit);
     void allVisitedFalse();
     // Single-source shortest path - Greedy
-    void dijkstraShortestPath(const T &s);
+    template<class Queue = DIJKSTRA_QUEUE> void dijkstraShortestPath(const T &s);
     void unweightedShortestPath(const T &s);
 
     // FP03B - Single-shource shortest path - Dynamic Programming - Bellman-Ford
@@ -159,24 +221,28 @@ public:
     std::vector<T> getPath(const T &origin, const T &dest) const; //TODO...
 
     // FP03B - All-pair shortest path -  Dynamic Programming - Floyd-Warshall
-    void floydWarshallShortestPath(); //TODO...
-    std::vector<T> getfloydWarshallPath(const T &origin, const T &dest) const; //TODO...
+    void floydWarshallShortestPath(int threads = ThreadPool::defaultThreads());
+    int getfloydWarshallDist(const T &origin, const T &dest) const;
+    std::vector<T> getfloydWarshallPath(const T &origin, const T &dest) const;
 
     int edmondKarpFlux(T st, T ta);
-    Graph<T> residualGrid();
+    int dinicFlux(T st, T ta);
+    int pushRelabelFlux(T st, T ta);
+    int parallelPushRelabelFlux(T st, T ta, int threads);
     void zeroFlux();
 
     int increaseGroupSize(T st, T ta, int inc);
     void auxTest2_4();
 
-    void topoSort(T st, std::stack<Vertex<T>*> &stack);
     int longestPath(T st, T ta);
 
     void printGraph();
 
+    WaitingTimes<T> waitingTimes(T st, T ta);
     void vertexTime(T st, T ta);
+    CriticalPath<T> criticalPath(T st, T ta);
     vector<vector<T>> capacityOrEdges(T st, T ta);
-    map<vector<int>, int> filterPathsByDominance();
+    PathStore<T> filterPathsByDominance() const;
 };
 
 template<class T>
@@ -209,6 +275,11 @@ void Edge<T>::setWeight(int weight) {
     Edge::weight = weight;
 }
 
+template<class T>
+Vertex<T> *Edge<T>::getDest() const {
+    return dest;
+}
+
 template<class T>
 int Edge<T>::getCapacity() const {
     return capacity;
@@ -226,30 +297,32 @@ int Graph<T>::getNumVertex() const {
 }
 
 template <class T>
-std::vector<Vertex<T> *> Graph<T>::getVertexSet() const {
+const std::vector<Vertex<T> *> &Graph<T>::getVertexSet() const {
     return vertexSet;
 }
 
 /*
  * Auxiliary function to find a vertex with a given content.
+ * O(1): goes through the id index kept by addVertex.
  */
 template <class T>
 Vertex<T> * Graph<T>::findVertex(const T &in) const {
-    for (auto v : vertexSet)
-        if (v->info == in)
-            return v;
-    return nullptr;
+    int i = findVertexIdx(in);
+    return i == -1 ? nullptr : vertexSet[i];
 }
 
 /*
  * Finds the index of the vertex with a given content.
+ * Integral ids numbered 1..N (as in the Tests/ datasets) live in a dense array, anything else in a hash index.
  */
 template <class T>
 int Graph<T>::findVertexIdx(const T &in) const {
-    for (unsigned i = 0; i < vertexSet.size(); i++)
-        if (vertexSet[i]->info == in)
-            return i;
-    return -1;
+    if constexpr (std::is_integral<T>::value) {
+        if (in >= 0 && (size_t) in < denseIdx.size() && denseIdx[in] != -1)
+            return denseIdx[in];
+    }
+    auto it = sparseIdx.find(in);
+    return it == sparseIdx.end() ? -1 : it->second;
 }
 /*
  *  Adds a vertex with a given content or info (in) to a graph (this).
@@ -257,9 +330,24 @@ int Graph<T>::findVertexIdx(const T &in) const {
  */
 template <class T>
 bool Graph<T>::addVertex(const T &in) {
-    if (findVertex(in) != nullptr)
+    if (findVertexIdx(in) != -1)
         return false;
+    int i = vertexSet.size();
+    bool dense = false;
+    if constexpr (std::is_integral<T>::value) {
+        // only grow the dense array while it stays proportional to the number of vertices
+        dense = in >= 0 && (size_t) in <= std::max<size_t>(2 * vertexSet.size(), numberNodes) + 1;
+        if (dense) {
+            if ((size_t) in >= denseIdx.size()) denseIdx.resize(in + 1, -1);
+            denseIdx[in] = i;
+        }
+    }
+    if (!dense) sparseIdx[in] = i;
     vertexSet.push_back(new Vertex<T>(in));
+    vertexSet.back()->idx = i;
+    flowSession.close();
+    topoValid = false;
+    fluxCsrValid = false;
     return true;
 }
 
@@ -274,7 +362,33 @@ bool Graph<T>::addEdge(const T &sourc, const T &dest, int d, int c, int w) {
     auto v2 = findVertex(dest);
     if (v1 == nullptr || v2 == nullptr)
         return false;
+    v2->incoming.emplace_back(v1->idx, v1->adj.size());
     v1->addEdge(v2, d, c, w);
+    flowSession.close();
+    topoValid = false;
+    fluxCsrValid = false;
+    return true;
+}
+
+/*
+ * Reserves room for n vertices, so bulk loading doesn't regrow the vertex set or the id index.
+ */
+template <class T>
+void Graph<T>::reserveVertices(int n) {
+    vertexSet.reserve(n);
+    if constexpr (std::is_integral<T>::value) denseIdx.reserve(n + 1);
+}
+
+/*
+ * Reserves room for n outgoing edges in the adjacency list of the vertex with a given content (in).
+ * Returns false if the vertex does not exist.
+ */
+template <class T>
+bool Graph<T>::reserveEdges(const T &in, int n) {
+    auto v = findVertex(in);
+    if (v == nullptr)
+        return false;
+    v->adj.reserve(n);
     return true;
 }
 
@@ -315,20 +429,37 @@ inline bool Graph<T>::relax(Vertex<T> *v, Vertex<T> *w, int weight) {
         return false;
 }
 
+///Dijkstra's algorithm on the durations: sets dist and path of every vertex
+///The priority queue is a policy from DijkstraQueues.h, one of the types in dijkstraQueues, so results can't depend on the order it breaks ties in:
+///when several predecessors give the same distance over a positive duration, path is the one earliest in vertexSet
+///\tparam Queue priority queue policy
+///\param origin start vertex
 template<class T>
+template<class Queue>
 void Graph<T>::dijkstraShortestPath(const T &origin) { //uses duration instead of weight
     auto s = initSingleSource(origin);
-    MutablePriorityQueue<Vertex<T>> q;
-    q.insert(s);
+    int maxDuration = 0;
+    for(Vertex<T>* v: vertexSet){
+        for(const Edge<T> &e: v->adj) maxDuration = std::max(maxDuration, e.duration);
+    }
+    Queue &q = std::get<Queue>(dijkstraQueues);
+    q.reset(vertexSet.size(), maxDuration);
+    s->visited = false; //visited marks settled vertices
+    q.push(s->idx, 0);
     while( ! q.empty() ) {
-        auto v = q.extractMin();
-        for(Edge<T> e : v->adj) {
-            auto oldDist = e.dest->dist;
-            if (relax(v, e.dest, e.duration)) {
-                if (oldDist == INF)
-                    q.insert(e.dest);
-                else
-                    q.decreaseKey(e.dest);
+        Vertex<T>* v = vertexSet[q.pop()];
+        if(v->visited) continue;
+        v->visited = true;
+        for(const Edge<T> &e : v->adj) {
+            Vertex<T>* w = e.dest;
+            int d = v->dist + e.duration;
+            if(d < w->dist){
+                w->dist = d;
+                w->path = v;
+                q.push(w->idx, d);
+            }
+            else if(d == w->dist && e.duration > 0 && v->idx < w->path->idx){
+                w->path = v;
             }
         }
     }
@@ -337,15 +468,14 @@ void Graph<T>::dijkstraShortestPath(const T &origin) { //uses duration instead o
 template<class T>
 void Graph<T>::unweightedShortestPath(const T &orig) {
     auto s = initSingleSource(orig);
-    std::queue< Vertex<T>* > q;
-    q.push(s);
+    bfsQueue.clear();
+    bfsQueue.push_back(s);
     s->visited = true;
-    while( ! q.empty() ) {
-        auto v = q.front();
-        q.pop();
-        for(auto e: v->adj)
+    for(size_t head = 0; head < bfsQueue.size(); head++) {
+        auto v = bfsQueue[head];
+        for(const Edge<T> &e: v->adj)
             if (relax(v, e.dest, 1)) {
-                q.push(e.dest);
+                bfsQueue.push_back(e.dest);
                 e.dest->visited = true;
             }
     }
@@ -365,12 +495,12 @@ void Graph<T>::bellmanFordShortestPath(const T &orig) {
 template<class T>
 std::vector<T> Graph<T>::getPath(const T &origin, const T &dest) const{
     std::vector<T> res;
-    Vertex<T> pred = *findVertex(dest); //pred = dest
-    if(!pred.visited) return res;
-    res.push_back(pred.getInfo());
-    while(pred.info != origin){
-        pred = *(pred.path);
-        res.push_back(pred.getInfo());
+    const Vertex<T>* pred = findVertex(dest); //pred = dest
+    if(!pred->visited) return res;
+    res.push_back(pred->info);
+    while(pred->info != origin){
+        pred = pred->path;
+        res.push_back(pred->info);
     }
     //reverse vector
     std::reverse(res.begin(), res.end());
@@ -381,32 +511,40 @@ std::vector<T> Graph<T>::getPath(const T &origin, const T &dest) const{
 
 /**************** All Pairs Shortest Path  ***************/
 
-template <class T>
-void deleteMatrix(T **m, int n) {
-    if (m != nullptr) {
-        for (int i = 0; i < n; i++)
-            if (m[i] != nullptr)
-                delete [] m[i];
-        delete [] m;
+///All-pairs shortest paths on the durations, see FloydWarshall: O(V^3) work, split in tiles over threads
+///Sets the distances and paths read by getfloydWarshallDist and getfloydWarshallPath, until the next call
+///\param threads number of threads
+template<class T>
+void Graph<T>::floydWarshallShortestPath(int threads) {
+    floydWarshall.reset(vertexSet.size());
+    for(Vertex<T>* v: vertexSet){
+        for(const Edge<T> &edge: v->adj) floydWarshall.addEdge(v->idx, edge.dest->idx, edge.duration);
     }
+    floydWarshall.run(threads);
 }
 
-template <class T>
-Graph<T>::~Graph() {
-    deleteMatrix(W, vertexSet.size());
-    deleteMatrix(P, vertexSet.size());
-}
-
+///Should be used after floydWarshallShortestPath
+///\param orig number associated with Origin Vertex
+///\param dest number associated with Destination Vertex
+///@return duration of the shortest path from orig to dest, INF if there's none
 template<class T>
-void Graph<T>::floydWarshallShortestPath() {
-    //implement this
+int Graph<T>::getfloydWarshallDist(const T &orig, const T &dest) const{
+    int s = findVertexIdx(orig), t = findVertexIdx(dest);
+    if(s == -1 || t == -1 || std::max(s, t) >= floydWarshall.getNumVertex()) return INF;
+    int dist = floydWarshall.getDist(s, t);
+    return dist == FloydWarshall::INFTY ? INF : dist;
 }
 
-
+///Should be used after floydWarshallShortestPath
+///\param orig number associated with Origin Vertex
+///\param dest number associated with Destination Vertex
+///@return Vector of numbers associated with Vertexes in the shortest path, in order, empty if there's none
 template<class T>
 std::vector<T> Graph<T>::getfloydWarshallPath(const T &orig, const T &dest) const{
     std::vector<T> res;
-    //implement this
+    int s = findVertexIdx(orig), t = findVertexIdx(dest);
+    if(s == -1 || t == -1 || std::max(s, t) >= floydWarshall.getNumVertex()) return res;
+    for(int v: floydWarshall.getPath(s, t)) res.push_back(vertexSet[v]->info);
     return res;
 }
 
@@ -432,175 +570,204 @@ void Graph<T>::setNumberEdges(int numberEdges) {
 
 ///Algorithm to calculate the maximum size of a group that can travel separately
 ///Based on the Edmond Karp variant of the Ford Fulkerson method for determining maximum flow
-///Sets appropriate flux for each edge
+///The residual grid is kept implicitly on the edges, so each augmentation costs one BFS plus the path length
+///Sets appropriate flux for each edge and sets paths to its decomposition
 ///\param st number associated with start vertex
 ///\param ta number associated with target vertex
-///@return maximum group size for the graph
+///@return maximum group size for the graph, 0 if start and target are the same vertex
 template<class T>
 int Graph<T>::edmondKarpFlux(T st, T ta) {
-    Vertex<T> origin(st);
-    std::vector<T> path;
-    int resCap = INF;
-    Graph<T> resGrid;
+    Vertex<T> *origin = findVertex(st), *target = findVertex(ta);
+    int maxFlux = 0;
 
     zeroFlux();
-
-    //determine residual grid
-    resGrid = residualGrid();
-    resGrid.unweightedShortestPath(st);
-    path = resGrid.getPath(st, ta);
-    Vertex<T> destination = *(resGrid.findVertex(ta));
+    //nothing flows from a vertex to itself, and the search below would keep finding the empty path
+    if(origin == target){
+        paths.clear();
+        return 0;
+    }
 
     //while there is a path in the Residual Grid
-    while(destination.visited){
-
-        //find minimun Cf in path
-        for(int i = 0; i < path.size() -1; i++){
-            for(Edge<T> edge: (resGrid.findVertex(path[i]))->adj){
-                //found the edge of the path
-                if(edge.dest->info == resGrid.findVertex(path[i+1])->info){
-                    resCap = std::min(edge.getWeight(), resCap);
-                }
-            }
-        }
-
-        for(int i = 0; i < path.size() - 1; i++){
-            for(Edge<T> &edge: findVertex(path[i])->adj){
-                //found the edge of the path
-                if(edge.dest->info == findVertex(path[i+1])->info){
-                    edge.setFlux(resCap + edge.getFlux());
-                }
-            }
-        }
+    while(residualBfs(origin, target)){
+        maxFlux += augmentResidualPath(origin, target, INF);
+    }
+    decomposeFlux(origin->idx, target->idx);
+    return maxFlux;
+}
 
-        pair<vector<T>, int> res;
-        res.first = path;
-        res.second = resCap;
-        if (!paths.insert(res).second) {
-            paths.find(path)->second += resCap;
-        }
+///Algorithm to calculate the maximum size of a group that can travel separately
+///Based on Dinic's algorithm (BFS level graph + blocking flow), run on a CSR copy of the graph
+///Sets appropriate flux for each edge and sets paths to its decomposition, like edmondKarpFlux
+///\param st number associated with start vertex
+///\param ta number associated with target vertex
+///@return maximum group size for the graph
+template<class T>
+int Graph<T>::dinicFlux(T st, T ta) {
+    CsrGraph<T> csr(*this);
+    int maxFlux = csr.dinicFlux(findVertexIdx(st), findVertexIdx(ta));
+    csr.writeFlux(*this);
+    flowSession.close();
+    routedFrom = routedTo = -1;
+    paths = std::move(csr.paths);
+    return maxFlux;
+}
 
-        //determine residual grid
-        resGrid = residualGrid();
-        resGrid.unweightedShortestPath(st);
-        path = resGrid.getPath(st, ta);
-        destination = *(resGrid.findVertex(ta));
-    }
+///Algorithm to calculate the maximum size of a group that can travel separately
+///Based on the highest-label push-relabel method with global relabeling and the gap heuristic, run on a CSR copy of the graph
+///Sets appropriate flux for each edge and sets paths to its decomposition
+///\param st number associated with start vertex
+///\param ta number associated with target vertex
+///@return maximum group size for the graph
+template<class T>
+int Graph<T>::pushRelabelFlux(T st, T ta) {
+    CsrGraph<T> csr(*this);
+    int maxFlux = csr.pushRelabelFlux(findVertexIdx(st), findVertexIdx(ta));
+    csr.writeFlux(*this);
+    flowSession.close();
+    routedFrom = routedTo = -1;
+    paths = std::move(csr.paths);
+    return maxFlux;
+}
 
-    origin = *(findVertex(st));
-    int maxFlux = 0;
-    for(Edge<T> edge: origin.adj){
-        maxFlux+= edge.getFlux();
-    }
+///Algorithm to calculate the maximum size of a group that can travel separately
+///Based on a lock-free push-relabel method where several threads discharge vertices at the same time
+///Sets appropriate flux for each edge and sets paths to its decomposition
+///\param st number associated with start vertex
+///\param ta number associated with target vertex
+///\param threads number of threads to use
+///@return maximum group size for the graph
+template<class T>
+int Graph<T>::parallelPushRelabelFlux(T st, T ta, int threads) {
+    CsrGraph<T> csr(*this);
+    int maxFlux = ParallelPushRelabel<T>(csr, threads).run(findVertexIdx(st), findVertexIdx(ta));
+    csr.writeFlux(*this);
+    flowSession.close();
+    routedFrom = routedTo = -1;
+    paths = std::move(csr.paths);
     return maxFlux;
 }
-///Creates a residual grid graph based on the current graph
-///@return graph object of the residual grid
+
+///Breadth-first search on the residual grid, kept implicitly on the edges:
+///an edge u->v with flux f and capacity c offers c - f from u to v and f from v to u
+///\param s start vertex
+///\param t target vertex
+///\param minResidual smallest residual capacity an arc needs to be used
+///@return true if t can be reached; the path is then stored in the path and pathEdge fields of its vertices
 template<class T>
-Graph<T> Graph<T>::residualGrid() {
-    Graph<T> residualGrid;
-    //add all vertexes
-    for(auto v: vertexSet){
-        residualGrid.addVertex(v->info);
-    }
+bool Graph<T>::residualBfs(Vertex<T> *s, Vertex<T> *t, int minResidual) {
     for(Vertex<T>* v: vertexSet){
-        for(Edge<T> edge : v->adj){
-            //Cf(u,v)
-            if(edge.capacity - edge.getFlux() > 0) residualGrid.addEdge(v->info, edge.dest->info, edge.duration, edge.capacity, edge.capacity - edge.getFlux());
+        v->visited = false;
+    }
+    bfsQueue.clear();
+    s->visited = true;
+    bfsQueue.push_back(s);
+    for(size_t head = 0; head < bfsQueue.size() && !t->visited; head++){
+        Vertex<T>* v = bfsQueue[head];
+        //Cf(u,v)
+        for(int i = 0; i < (int) v->adj.size(); i++){
+            Vertex<T>* w = v->adj[i].dest;
+            if(!w->visited && v->adj[i].capacity - v->adj[i].flux >= minResidual){
+                w->visited = true;
+                w->path = v;
+                w->pathEdge = i;
+                bfsQueue.push_back(w);
+            }
+        }
+        //Cf(v,u)
+        for(const std::pair<int, int> &in: v->incoming){
+            Vertex<T>* w = vertexSet[in.first];
+            if(!w->visited && w->adj[in.second].flux >= minResidual){
+                w->visited = true;
+                w->path = v;
+                w->pathEdge = ~in.second;
+                bfsQueue.push_back(w);
+            }
         }
     }
+    return t->visited;
+}
 
-    for(auto v: vertexSet){
-        for(Edge<T> edge : v->adj){
-            //Cf(v,u)
-            if(edge.getFlux() > 0) residualGrid.addEdge(edge.dest->info ,v->info, edge.duration, edge.capacity, edge.getFlux());
-        }
+///Pushes flow along the path found by the last residualBfs
+///\param s start vertex
+///\param t target vertex
+///\param limit maximum amount to push
+///@return the amount pushed: the minimum of limit and the residual capacities along the path
+template<class T>
+int Graph<T>::augmentResidualPath(Vertex<T> *s, Vertex<T> *t, int limit) {
+    int resCap = limit;
+    for(Vertex<T>* v = t; v != s; v = v->path){
+        if(v->pathEdge >= 0) resCap = std::min(resCap, v->path->adj[v->pathEdge].capacity - v->path->adj[v->pathEdge].flux);
+        else resCap = std::min(resCap, v->adj[~v->pathEdge].flux);
+    }
+    for(Vertex<T>* v = t; v != s; v = v->path){
+        if(v->pathEdge >= 0) v->path->adj[v->pathEdge].flux += resCap;
+        else v->adj[~v->pathEdge].flux -= resCap;
+    }
+    return resCap;
+}
+
+///Sets the paths field to a decomposition of the flux from s to t, see CsrGraph::decomposeFlux.
+///Flow cycles are cancelled on the way, which changes the flux under an open FlowSession, so it's closed then.
+///The CSR copy is only rebuilt after edges or vertices are added, so repeated calls cost O(V + E) plus the paths.
+///\param s position of the start vertex
+///\param t position of the target vertex
+template<class T>
+void Graph<T>::decomposeFlux(int s, int t) {
+    if (!fluxCsrValid) {
+        fluxCsr = CsrGraph<T>(*this);
+        fluxCsrValid = true;
+    } else {
+        fluxCsr.readFlux(*this);
     }
-    return residualGrid;
+    if (fluxCsr.decomposeFlux(s, t)) {
+        fluxCsr.writeFlux(*this);
+        flowSession.close();
+    }
+    std::swap(paths, fluxCsr.paths);
 }
+
 ///Sets flux of every edge on the graph to zero
 template<class T>
 void Graph<T>::zeroFlux() {
     for(auto v: vertexSet){
-        for(int i = 0; i < v->adj.size(); i++){
-            v->adj[i].setFlux(0);
+        for(Edge<T> &edge: v->adj){
+            edge.setFlux(0);
         }
     }
+    flowSession.close();
+    routedFrom = routedTo = -1;
 }
 
 ///Algorithm to increase group size based on previous paths
-///Based on the Edmond Karp variant of the Ford Fulkerson method for determining maximum flux
-///Sets appropriate flux for each edge
+///Keeps a FlowSession on the current flux, so a sequence of increases costs about as much as a single
+///maximum flow: the flow value, the level graph and the current arcs are reused from one call to the next
+///Sets appropriate flux for each edge and sets paths to the decomposition of the whole flux
 ///\param st number associated with start vertex
 ///\param ta number associated with target vertex
 ///\param inc amount to increase group size by
 ///@return how much the group size was increased by or -1 if it cant be increased by the desired amount
 template<class T>
 int Graph<T>::increaseGroupSize(T st, T ta, int inc) {
-    Vertex<T> origin = *(findVertex(st));
-    std::vector<T> path;
-    int resCap = INF;
-    Graph<T> resGrid;
-
-    //get initial flux
-    int initialFlux = 0;
-    for(Edge<T> edge: origin.adj){
-        initialFlux += edge.getFlux();
-    }
-    int newFlux = initialFlux;
-
-    //determine residual grid
-    resGrid = residualGrid();
-    resGrid.unweightedShortestPath(st);
-    path = resGrid.getPath(st, ta);
-    Vertex<T> destination = *(resGrid.findVertex(ta));
-
-    //while there is a path in the Residual Grid
-    while((newFlux - initialFlux < inc) && destination.visited){
-
-        //find minimun Cf in path
-        for(int i = 0; i < path.size() -1; i++){
-            for(Edge<T> edge: (resGrid.findVertex(path[i]))->adj){
-                //found the edge of the path
-                if(edge.dest->info == resGrid.findVertex(path[i+1])->info){
-                    resCap = std::min(edge.getWeight(), resCap);
-                }
-            }
-        }
-
-        for(int i = 0; i < path.size() -1; i++){
-            for(Edge<T> &edge: findVertex(path[i])->adj){
-                //found the edge of the path
-                if(edge.dest->info == findVertex(path[i+1])->info){
-                    edge.setFlux(resCap + edge.getFlux());
-                }
-            }
-        }
-
-        pair<vector<T>, int> res;
-        res.first = path;
-        res.second = resCap;
-        if (!paths.insert(res).second) {
-            paths.find(path)->second += resCap;
-        }
-
-        //determine residual grid
-        resGrid = residualGrid();
-        resGrid.unweightedShortestPath(st);
-        path = resGrid.getPath(st, ta);
-        destination = *(resGrid.findVertex(ta));
-
-        //update origin
-        origin = *(findVertex(st));
-        //determine current max-flux
-        newFlux = 0;
-        for(Edge<T> edge: origin.adj){
-            newFlux+= edge.getFlux();
-        }
+    int s = findVertexIdx(st), t = findVertexIdx(ta);
+    //a group already at its target grows on the single-vertex path FindPathGivenGroupSize gave it
+    if(s == t){
+        int group = routedFrom == s && routedTo == s ? routedGroup : 0;
+        zeroFlux();
+        paths.clear();
+        paths.add({st}, group + inc);
+        routedFrom = routedTo = s;
+        routedGroup = group + inc;
+        return inc;
     }
+    if(!flowSession.isOpenFor(s, t)) flowSession.open(*this, s, t);
+    int increase = flowSession.increase(*this, inc);
+    decomposeFlux(s, t);
+    routedFrom = s;
+    routedTo = t;
+    routedGroup = flowSession.getFlow();
     //if it reaches full flux before increasing enough, it means its impossible to increase by the desired amount
-    if(newFlux - initialFlux < inc) return -1;
-    return newFlux - initialFlux;
+    if(increase < inc) return -1;
+    return increase;
 }
 
 ///Prints the caracteristics of all edges in the graph
@@ -624,37 +791,27 @@ void Graph<T>::printGraph(){
 ///Computes the highest capacity path in the graph
 ///Works for unseperable groups
 ///Based on the algorithm for higest capacity path in the theory slides
+///Capacities are usually small integers, so a bucket queue indexed by capacity is used whenever the largest one
+///isn't bigger than the graph itself; otherwise a heap is
 ///\param st number associated with start vertex
 ///\param ta number associated with target vertex
-///@returns the minimum capacity, in the highest capacity path in the graph
+///@returns the minimum capacity, in the highest capacity path in the graph, 0 if end can't be reached
 template<class T>
 int Graph<T>::firstAlgorithm(T start, T end) {
-    MinHeap<Vertex<T>*, int> heap(numberNodes, nullptr);
+    Vertex<T> * origin = findVertex(start);
+    int maxCapacity = 0;
+    size_t edges = 0;
     for(Vertex<T>* v: vertexSet){
-        v->path = nullptr;
-        v->cap = 0;
-        v->visited = true;
-        heap.insert(v, -(v->cap));
+        for(const Edge<T> &edge: v->adj) maxCapacity = std::max(maxCapacity, edge.capacity);
+        edges += v->adj.size();
     }
-    Vertex<T> * origin = findVertex(start);
-    origin->cap = INF;
-    heap.decreaseKey(origin, -INF);
-    while(heap.getSize() > 0){
-       Vertex<T>* vec = heap.removeMin();
+    if((size_t) maxCapacity <= vertexSet.size() + edges) bucketWidestPath(origin, maxCapacity);
+    else heapWidestPath(origin);
 
-        //std::pop_heap(heap.begin(), heap.end());
-        for(Edge<T> edge: vec->adj){
-            if(std::min(vec->cap,edge.capacity) > edge.dest->cap){
-                edge.dest->cap = std::min(vec->cap,edge.capacity);
-                edge.dest->path = vec;
-                heap.decreaseKey(edge.dest, -(edge.dest->cap));
-            }
-        }
-    }
-    
     Vertex<T>* vertex;
     int mincap = INF;
     vector<T> path = getPath(start, end);
+    if(path.empty()) return 0;
     for(T info : path){
         vertex = findVertex(info);
         mincap = std::min(mincap, vertex->cap);
@@ -665,29 +822,131 @@ int Graph<T>::firstAlgorithm(T start, T end) {
     return mincap;
 }
 
+///Widest path from origin with a heap: sets the cap and path fields of every vertex
+///Vertices enter the heap when first reached, keyed by their position and prioritised by minus their width, then
+///by when they got that width: equally wide vertices leave first come, first served, as from bucketWidestPath's
+///buckets, so both give the same paths
+///\param origin start vertex
+template<class T>
+void Graph<T>::heapWidestPath(Vertex<T> *origin) {
+    DaryHeap<std::pair<int, int>> heap(vertexSet.size());
+    int widened = 0;
+    for(Vertex<T>* v: vertexSet){
+        v->path = nullptr;
+        v->cap = 0;
+        v->visited = false;
+    }
+    origin->cap = INF;
+    origin->visited = true;
+    heap.insert(origin->idx, {-INF, widened++});
+    while(heap.getSize() > 0){
+        Vertex<T>* vec = vertexSet[heap.removeMin()];
+        for(const Edge<T> &edge: vec->adj){
+            if(std::min(vec->cap,edge.capacity) > edge.dest->cap){
+                edge.dest->cap = std::min(vec->cap,edge.capacity);
+                edge.dest->path = vec;
+                edge.dest->visited = true;
+                if(heap.hasKey(edge.dest->idx)) heap.decreaseKey(edge.dest->idx, {-(edge.dest->cap), widened++});
+                else heap.insert(edge.dest->idx, {-(edge.dest->cap), widened++});
+            }
+        }
+    }
+}
+
+///Widest path from origin with a bucket queue indexed by capacity: sets the cap and path fields of every vertex
+///The width of a vertex never exceeds the width of the one it's reached from, so the buckets are emptied from
+///maxCapacity down in a single pass; a vertex is only bucketed when its width strictly grows, and stale entries
+///(whose width has grown since) are skipped. A bucket is emptied first in, first out, the order heapWidestPath
+///breaks ties in. O(V + E + maxCapacity), with no heap and no hashing.
+///\param origin start vertex
+///\param maxCapacity largest edge capacity in the graph
+template<class T>
+void Graph<T>::bucketWidestPath(Vertex<T> *origin, int maxCapacity) {
+    for(Vertex<T>* v: vertexSet){
+        v->path = nullptr;
+        v->cap = 0;
+        v->visited = false;
+    }
+    if(widthBuckets.size() < (size_t) maxCapacity + 1) widthBuckets.resize(maxCapacity + 1);
+    auto relax = [this](Vertex<T>* v){
+        for(const Edge<T> &edge: v->adj){
+            int through = std::min(v->cap, edge.capacity);
+            if(through > edge.dest->cap){
+                edge.dest->cap = through;
+                edge.dest->path = v;
+                edge.dest->visited = true;
+                widthBuckets[through].push_back(edge.dest);
+            }
+        }
+    };
+    origin->cap = INF;
+    origin->visited = true;
+    relax(origin);
+    for(int c = maxCapacity; c > 0; c--){
+        std::vector<Vertex<T> *> &bucket = widthBuckets[c];
+        //relax may append to the bucket being emptied, so it's indexed rather than iterated
+        for(size_t i = 0; i < bucket.size(); i++){
+            Vertex<T>* v = bucket[i];
+            if(v->cap == c && v != origin) relax(v);
+        }
+        bucket.clear();
+    }
+}
+
 template<class T>
 bool Edge<T>::operator<(const Edge<T> & edge) const{
     return capacity < edge.getCapacity();
 }
 
+///Kahn's algorithm, iterative and with no allocation once order has grown to the vertex count
+///\param order receives the vertices in topological order; vertices on a cycle are left out
+///\param fluxOnly whether to only follow the edges that carry flux
+template<class T>
+void Graph<T>::kahn(std::vector<Vertex<T> *> &order, bool fluxOnly) {
+    inDegree.assign(vertexSet.size(), 0);
+    for(Vertex<T>* v: vertexSet){
+        if(!fluxOnly) inDegree[v->idx] = v->incoming.size();
+        else for(const Edge<T> &edge: v->adj) if(edge.flux != 0) inDegree[edge.dest->idx]++;
+    }
+    order.clear();
+    for(Vertex<T>* v: vertexSet){
+        if(inDegree[v->idx] == 0) order.push_back(v);
+    }
+    for(size_t head = 0; head < order.size(); head++){
+        for(const Edge<T> &edge: order[head]->adj){
+            if((!fluxOnly || edge.flux != 0) && --inDegree[edge.dest->idx] == 0) order.push_back(edge.dest);
+        }
+    }
+}
+
+///@return every vertex in topological order, computed once and kept until an edge or vertex is added;
+///shorter than the vertex set if the graph has a cycle
+template<class T>
+const std::vector<Vertex<T> *> &Graph<T>::topologicalOrder() {
+    if(!topoValid){
+        kahn(topoOrder, false);
+        topoValid = true;
+    }
+    return topoOrder;
+}
+
+///@return a topological order of the subgraph of edges carrying flux: the cached order of the whole graph when
+///it's acyclic, since it's valid for any subset of its edges, otherwise a fresh Kahn pass over the flux edges
+template<class T>
+const std::vector<Vertex<T> *> &Graph<T>::fluxTopologicalOrder() {
+    if(topologicalOrder().size() == vertexSet.size()) return topoOrder;
+    kahn(fluxOrder, true);
+    return fluxOrder;
+}
+
 ///Computes the longest path, in duration, between 2 nodes
-///Similar to dijkstra's algorithm for shortest distance paths, using topological sort
+///Single sweep over the edges carrying flux, in topological order
 ///Should be used after a flux setting algorithm
 ///\param st number associated with start vertex
 ///\param ta number associated with target vertex
 ///@returns longest duration between ta and st nodes
 template<class T>
 int Graph<T>::longestPath(T st, T ta) {
-    std::stack<Vertex<T>*> stack;
-    //set all as not visited
-    for(Vertex<T>* vertex: vertexSet){
-        vertex->visited = false;
-    }
-    //store topological sort
-    for(Vertex<T>* vertex: vertexSet){
-        if(!(vertex->visited)) topoSort(vertex->info, stack);
-    }
-
     //set all distances to infinite
     for(Vertex<T>* vertex: vertexSet){
         vertex->dist = NINF;
@@ -695,22 +954,14 @@ int Graph<T>::longestPath(T st, T ta) {
     Vertex<T>* origin = findVertex(st);
     origin->dist = 0;
 
-    Vertex<T>* dest;
     //process verteses in topological order
-    while(stack.size()>0){
-        Vertex<T>* node = stack.top();
-        stack.pop();
-
-        //adjacent
-        if(node->dist != NINF){
-            for(Edge<T> edge : node->adj){
-                if(edge.flux != 0){
-                    dest = edge.dest;
-                    if(dest->dist < node->dist + edge.duration){
-                        dest->dist = node->dist + edge.duration;
-                        dest->path = findVertex(node->info);
-                    }
-                }
+    for(Vertex<T>* node: fluxTopologicalOrder()){
+        if(node->dist == NINF) continue;
+        for(const Edge<T> &edge : node->adj){
+            Vertex<T>* dest = edge.dest;
+            if(edge.flux != 0 && dest->dist < node->dist + edge.duration){
+                dest->dist = node->dist + edge.duration;
+                dest->path = node;
             }
         }
     }
@@ -718,131 +969,204 @@ int Graph<T>::longestPath(T st, T ta) {
     return target->dist;
 }
 
-///Inserts nodes on a stack, in topological order
-///\param st number associated with start vertex
-///\param reference to a stack of pointers of nodes, where the nodes will be inserted in
+///Earliest (et, over every edge) and latest (lt, over the edges carrying flux) arrival at every vertex, both in
+///the same sweep over the cached topological order
+///\param origin start vertex
+///@return false, touching nothing, if the graph has a cycle
 template<class T>
-void Graph<T>::topoSort(T st, std::stack<Vertex<T>*> &stack) {
-    Vertex<T>* origin = findVertex(st);
-    origin->visited = true;
-    for(Edge<T> edge : origin->adj){
-        if(!(edge.dest->visited) && (edge.flux != 0)) topoSort((edge.dest)->info, stack);
+bool Graph<T>::arrivalTimes(Vertex<T> *origin) {
+    const std::vector<Vertex<T> *> &order = topologicalOrder();
+    if(order.size() != vertexSet.size()) return false;
+    for(Vertex<T>* v: vertexSet){
+        v->et = INF;
+        v->lt = NINF;
+    }
+    origin->et = 0;
+    origin->lt = 0;
+    for(Vertex<T>* v: order){
+        if(v->et == INF) continue;
+        for(const Edge<T> &edge: v->adj){
+            Vertex<T>* w = edge.dest;
+            w->et = std::min(w->et, v->et + edge.duration);
+            if(v->lt != NINF && edge.flux != 0) w->lt = std::max(w->lt, v->lt + edge.duration);
+        }
     }
-    stack.push(origin);
+    return true;
 }
 
-///Computes the earliest and latest arrival at every node
-///Prints every node where people must wait for other people and how long they wait for
-///Dijkstra's algorithm is used to compute earliest arrival
-///LongestPath algorithm is used to compute latest arrival
+///Computes the earliest and latest arrival at every node, and so where people must wait for other people
+///On a DAG both come from one sweep over the topological order; otherwise Dijkstra's algorithm is used to compute
+///earliest arrival and the LongestPath algorithm to compute latest arrival
+///Should be used after a flux setting algorithm
+///\param st number associated with start vertex
+///\param ta number associated with target vertex
+///@return every vertex with a waiting time, in vertex set order, and the vertices with the biggest one
 template<class T>
-void Graph<T>::vertexTime(T st, T ta) {
-    dijkstraShortestPath(st);
-    for(Vertex<T>* v : vertexSet){
-        v->et = v->dist;
-    }
-    longestPath(st, ta);
-    for(Vertex<T>* v : vertexSet){
-        v->lt = v->dist;
+WaitingTimes<T> Graph<T>::waitingTimes(T st, T ta) {
+    if(!arrivalTimes(findVertex(st))){
+        dijkstraShortestPath(st);
+        for(Vertex<T>* v : vertexSet){
+            v->et = v->dist;
+        }
+        longestPath(st, ta);
+        for(Vertex<T>* v : vertexSet){
+            v->lt = v->dist;
+        }
     }
 
-    int maxD = 0;
-    std::vector<T> biggest;
+    WaitingTimes<T> res;
     for(Vertex<T>* v : vertexSet){
         if(((v->lt) - (v->et) != 0) && ((v->lt) > NINF) && ((v->et) != INF)){
-            std::cout << "Vertex: " << v->info << " Waiting: " << (v->lt) - (v->et) << std::endl;
-            if((v->lt) - (v->et) > maxD){
-                maxD = (v->lt) - (v->et);
-                biggest.erase(biggest.begin(), biggest.end());
-                biggest.push_back(v->info);
+            int wait = (v->lt) - (v->et);
+            res.waits.emplace_back(v->info, wait);
+            if(wait > res.biggest){
+                res.biggest = wait;
+                res.biggestNodes.assign(1, v->info);
             }
-            else if((v->lt) - (v->et) == maxD){
-                biggest.push_back(v->info);
+            else if(wait == res.biggest){
+                res.biggestNodes.push_back(v->info);
             }
         }
     }
-    std::cout << "Biggest waiting time: " << maxD << '\n';
-    for(auto node : biggest){
+    return res;
+}
+
+///Prints every node where people must wait for other people and how long they wait for, then the biggest waiting
+///time and where it happens, see waitingTimes
+template<class T>
+void Graph<T>::vertexTime(T st, T ta) {
+    WaitingTimes<T> res = waitingTimes(st, ta);
+    for(const std::pair<T, int> &wait : res.waits){
+        std::cout << "Vertex: " << wait.first << " Waiting: " << wait.second << std::endl;
+    }
+    std::cout << "Biggest waiting time: " << res.biggest << '\n';
+    for(auto node : res.biggestNodes){
         std::cout << "Node: " << node << '\n';
     }
 }
 
-///Algorithm to calculate the paths for a splittable group of a given size
-///Based on the Edmond Karp variant of the Ford Fulkerson method for determining maximum flow
-///Sets appropriate flux for each edge
+///Critical path analysis (CPM) of the subgraph of edges carrying flux, with vertices as events and edges as
+///activities: a forward sweep over the topological order gives the earliest time of every event, a backward
+///one the latest, and the floats of vertices and edges follow from both. O(V + E)
+///Should be used after a flux setting algorithm
 ///\param st number associated with start vertex
 ///\param ta number associated with target vertex
-///\param groupSize desired group size
-///@return map of the paths the group should take
+///@return the timing of every vertex and of every edge carrying flux, and which edges are critical
 template<class T>
-void Graph<T>::FindPathGivenGroupSize(T st, T ta, int groupSize) {
-    Vertex<T> origin(st);
-    std::vector<T> path;
-    std::vector<T> pathInfo;
-    int resCap = INF;
-    Graph<T> resGrid;
-    std::map<vector<T>, T> printablePath;
-
-//    zeroFlux();
+CriticalPath<T> Graph<T>::criticalPath(T st, T ta) {
+    CriticalPath<T> res;
+    res.nodes.resize(vertexSet.size());
     for(Vertex<T>* v: vertexSet){
-        for(int i = 0; i < v->adj.size(); i++){
-            v->adj[i].setFlux(0);
+        CpmNode<T> &node = res.nodes[v->idx];
+        node.info = v->info;
+        node.earliest = NINF;
+        node.latest = INF;
+    }
+    Vertex<T> *origin = findVertex(st), *target = findVertex(ta);
+    const std::vector<Vertex<T> *> &order = fluxTopologicalOrder();
+
+    res.nodes[origin->idx].earliest = 0;
+    for(Vertex<T>* v: order){
+        int earliest = res.nodes[v->idx].earliest;
+        if(earliest == NINF) continue;
+        for(const Edge<T> &edge: v->adj){
+            int &next = res.nodes[edge.dest->idx].earliest;
+            if(edge.flux != 0) next = std::max(next, earliest + edge.duration);
         }
     }
-
-    resGrid = residualGrid();
-    resGrid.unweightedShortestPath(st);
-    path = resGrid.getPath(st, ta);
-
-    //while there is a path in the Residual Grid
-    while(groupSize != 0){
-        resGrid = residualGrid();
-        resGrid.unweightedShortestPath(st);
-        path = resGrid.getPath(st, ta);
-        if (path.empty()) {
-            cout << "Couldn't find a path for the whole group. The biggest possible group's path goes as follows:\n";
-            break;
+    if(res.nodes[target->idx].earliest == NINF) return res;
+    res.duration = res.nodes[target->idx].earliest;
+
+    res.nodes[target->idx].latest = res.duration;
+    for(auto it = order.rbegin(); it != order.rend(); it++){
+        Vertex<T>* v = *it;
+        int &latest = res.nodes[v->idx].latest;
+        for(const Edge<T> &edge: v->adj){
+            int next = res.nodes[edge.dest->idx].latest;
+            if(edge.flux != 0 && next != INF) latest = std::min(latest, next - edge.duration);
         }
+    }
 
-        //find minimun Cf in path
-        for(int i = 0; i < path.size() -1; i++){
-            for(Edge<T> edge: (resGrid.findVertex(path[i]))->adj){
-                //found the edge of the path
-                if(edge.dest->info == resGrid.findVertex(path[i+1])->info){
-                    resCap = std::min(edge.getWeight(), resCap);
-                }
-            }
+    for(Vertex<T>* v: vertexSet){
+        CpmNode<T> &node = res.nodes[v->idx];
+        node.onNetwork = node.earliest != NINF && node.latest != INF;
+        if(!node.onNetwork) continue;
+        node.totalFloat = node.latest - node.earliest;
+        node.freeFloat = v == target ? 0 : INF;
+        for(const Edge<T> &edge: v->adj){
+            const CpmNode<T> &next = res.nodes[edge.dest->idx];
+            if(edge.flux == 0 || next.latest == INF) continue;
+            CpmEdge<T> activity;
+            activity.from = v->info;
+            activity.to = edge.dest->info;
+            activity.duration = edge.duration;
+            activity.earliestStart = node.earliest;
+            activity.earliestFinish = node.earliest + edge.duration;
+            activity.latestFinish = next.latest;
+            activity.latestStart = next.latest - edge.duration;
+            activity.totalFloat = activity.latestStart - activity.earliestStart;
+            activity.freeFloat = next.earliest - activity.earliestFinish;
+            activity.critical = activity.totalFloat == 0;
+            node.freeFloat = std::min(node.freeFloat, activity.freeFloat);
+            if(activity.critical) res.criticalEdges.push_back(res.edges.size());
+            res.edges.push_back(activity);
         }
+    }
+    return res;
+}
 
-        for(int i = 0; i < path.size() - 1; i++){
-            for(Edge<T> &edge: findVertex(path[i])->adj){
-                //found the edge of the path
-                if(edge.dest->info == findVertex(path[i+1])->info){
-                    edge.setFlux(resCap + edge.getFlux());
-                }
-            }
-        }
+///Algorithm to calculate the paths for a splittable group of a given size
+///Based on the Edmond Karp variant of the Ford Fulkerson method for determining maximum flow or, with
+///capacityScaling, on its capacity scaling variant: only arcs with at least delta residual capacity are used,
+///delta starting at the biggest power of two not above the largest capacity and the group size and halving
+///whenever no such path is left, so big bottlenecks are filled first in O(E^2 log U) instead of many tiny steps
+///Sets appropriate flux for each edge and sets the paths field to its decomposition: the paths the group should take
+///\param st number associated with start vertex
+///\param ta number associated with target vertex
+///\param groupSize desired group size
+///\param capacityScaling whether to use the capacity scaling variant
+///@return size of the group that was given paths: groupSize, or the biggest possible group if it doesn't fit
+template<class T>
+int Graph<T>::FindPathGivenGroupSize(T st, T ta, int groupSize, bool capacityScaling) {
+    Vertex<T> *origin = findVertex(st), *target = findVertex(ta);
+    int left = groupSize;
 
-        if (resCap > groupSize) {
-            resCap = groupSize;
-        }
+    zeroFlux();
+    routedFrom = origin->idx;
+    routedTo = target->idx;
+    //a group already at its target takes no edge: the whole group gets the single-vertex path
+    if(origin == target){
+        paths.clear();
+        paths.add({st}, groupSize);
+        routedGroup = groupSize;
+        return groupSize;
+    }
 
-        for (int i = 0; i < path.size(); i++) {
-            pathInfo.push_back(path[i]);
+    int delta = 1;
+    if(capacityScaling){
+        int maxCapacity = 0;
+        for(Vertex<T>* v: vertexSet){
+            for(const Edge<T> &edge: v->adj) maxCapacity = std::max(maxCapacity, edge.capacity);
         }
+        maxCapacity = std::min(maxCapacity, groupSize);
+        while(delta <= maxCapacity / 2) delta *= 2;
+    }
 
-        if (printablePath.find(pathInfo) == printablePath.end()) {
-            printablePath.insert(std::pair<vector<int>, int>(pathInfo, resCap));
-        } else {
-            printablePath.find(pathInfo)->second += resCap;
+    //while there is a path in the Residual Grid
+    while(left != 0){
+        if (!residualBfs(origin, target, delta)) {
+            if(delta > 1){
+                delta /= 2;
+                continue;
+            }
+            break;
         }
 
-        pathInfo.erase(pathInfo.begin(), pathInfo.end());
-
-        groupSize -= resCap;
+        left -= augmentResidualPath(origin, target, left);
     }
-
-    paths = printablePath;
+    decomposeFlux(origin->idx, target->idx);
+    routedGroup = groupSize - left;
+    return groupSize - left;
 }
 
 template<class T>
@@ -887,112 +1211,148 @@ vector<vector<T>> Graph<T>::capacityOrEdges(T st, T ta) {
 }
 
 ///Prints all the paths and how many people go through each of them
-///\param printablePath a map of paths, as a vector of nodes T, and number of people that can go through them
+///\param printablePath the paths, in lexicographic order, and number of people that can go through them
 template<class T>
-void Graph<T>::printPath(map<vector<T>, T> printablePath)
+void Graph<T>::printPath(const PathStore<T> &printablePath)
  {
     if (printablePath.empty()) {
         cout << "Seems like we've found no path!\n";
     } else {
-        for (auto x: printablePath) {
-            cout << x.second << " subjects go through this path: ";
-            for (auto i: x.first) {
-                cout << i << ", ";
+        for (int x: printablePath.lexicographicOrder()) {
+            cout << printablePath.getAmount(x) << " subjects go through this path: ";
+            for (const T *i = printablePath.begin(x); i != printablePath.end(x); i++) {
+                cout << *i << ", ";
             }
             cout << "arrived." << std::endl;
         }
     }
  }
 
-///Sets the paths field to be all the pareto-optimal solutions (paths) from origin to target nodes
+///Sets the paths field to be all the pareto-optimal solutions (paths) from origin to target nodes: one path for
+///every hop count that carries a strictly bigger group than any path with fewer hops.
+///Label-setting over hop layers: layer k holds the vertices whose widest walk of exactly k edges from the origin is
+///wider than any walk with fewer edges reaching them, since a label (k, width) is dominated by any (k' <= k,
+///width' >= width) at the same vertex. Each vertex is relabeled only when its width strictly grows, so the labels
+///are at most V times the number of distinct capacities and the engine is O(E * min(V, distinct capacities)).
+///A walk that wins a front point is a simple path: dropping a cycle would reach the target in fewer edges with no
+///smaller width.
 ///\param origin is the origin node
 ///\param target is the target node
 template<class T>
 void Graph<T>::paretoOptimalGroupSizeAndTransportShift(T origin, T target) {
-    vector<T> bfsVec, maxCapVec;
-    vector<vector<T>> res;
-    int bfsEdges, maxCapEdges, bfsCap=INF, maxCapCap;
-    unweightedShortestPath(origin);
-    bfsVec = getPath(origin, target);
-    bfsEdges = bfsVec.size();
-    for(int i = 0; i < bfsVec.size() - 1; i++){
-        Vertex<T> * v = findVertex(bfsVec[i]);
-        for (auto e : v->adj) {
-            if (e.dest->info == bfsVec[i+1]) {
-                bfsCap = std::min(bfsCap, e.capacity);
+    paths.clear();
+    Vertex<T>* s = findVertex(origin);
+    Vertex<T>* t = findVertex(target);
+    if(s == nullptr || t == nullptr) return;
+    labelWidth.assign(vertexSet.size(), 0);
+    labelPos.assign(vertexSet.size(), -1);
+    if(hopLayers.empty()) hopLayers.emplace_back();
+    hopLayers[0].assign(1, {s->idx, INF, -1});
+    labelWidth[s->idx] = INF;
+    for(size_t k = 0; !hopLayers[k].empty(); k++){
+        if(labelWidth[t->idx] == INF) break;  // nothing can beat a walk on which no edge is a bottleneck
+        if(hopLayers.size() == k + 1) hopLayers.emplace_back();
+        std::vector<HopLabel> &layer = hopLayers[k], &next = hopLayers[k + 1];
+        next.clear();
+        for(int i = 0; i < (int) layer.size(); i++){
+            if(layer[i].vertex == t->idx) continue;
+            int width = layer[i].width;
+            for(const Edge<T> &edge: vertexSet[layer[i].vertex]->adj){
+                int through = std::min(width, edge.capacity);
+                int w = edge.dest->idx;
+                if(through <= labelWidth[w]) continue;
+                labelWidth[w] = through;
+                if(labelPos[w] == -1){
+                    labelPos[w] = next.size();
+                    next.push_back({w, through, i});
+                }
+                else next[labelPos[w]] = {w, through, i};
             }
         }
+        int reached = labelPos[t->idx];
+        for(const HopLabel &label: next) labelPos[label.vertex] = -1;
+        if(reached == -1) continue;
+        for(size_t j = k + 1, i = reached; ; j--){
+            paths.push(vertexSet[hopLayers[j][i].vertex]->info);
+            if(j == 0) break;
+            i = hopLayers[j][i].pred;
+        }
+        paths.reverseOpen();
+        paths.commit(next[reached].width);
     }
+}
 
-    maxCapCap = firstAlgorithm(origin, target);
-    maxCapVec = getPath(origin, target);
-    maxCapEdges = maxCapVec.size();
-
-    vector<int> empty;
-    pair<vector<int>, int> bfsPath, maxCapPath;
-
-    bfsPath.first = bfsVec;
-    bfsPath.second = bfsCap;
-
-    maxCapPath.first = maxCapVec;
-    maxCapPath.second = maxCapCap;
-
-    allVisitedFalse();
-    recursivePathFinderLimited(origin, target, INF, bfsCap, maxCapEdges);
-
-    paths.insert(bfsPath);
-    paths.insert(maxCapPath);
-
-    paths = filterPathsByDominance();
+///Adds to the paths field the simple paths from origin to target allowed by the limits, with their capacities,
+///enumerated by a PathEnumerator on a frozen copy of the graph
+///\param origin is the origin node
+///\param target is the target node
+///\param limits which paths to look for and when to stop
+///\param threads number of worker threads
+///@return true if every such path was found, false if a limit stopped the search
+template<class T>
+bool Graph<T>::enumeratePaths(T origin, T target, const EnumerationLimits &limits, int threads) {
+    int s = findVertexIdx(origin), t = findVertexIdx(target);
+    if(s == -1 || t == -1) return true;
+    CsrGraph<T> csr(*this);
+    PathEnumerator<T> enumerator(csr, threads);
+    bool complete = enumerator.run(s, t, limits);
+    paths.addMax(enumerator.paths);
+    return complete;
 }
 
-///This function performs a recursive DFS on the graph looking for all simple paths from origin to target that are within the "pareto-optimal" limitations defined by the paretoOptimal method above.
-///\param bfsCap the minimum capacity limitation for a valid path to be explored
-///\param maxCapEdges the maximum path size for exploration worth
-///\param currentCap keeps the lesser edge capacity found during the path exploration, meaning the capacity that path can transport
-///\param current the current node from where the path will be searched for
-///\param target the target node for the path
+///Sets the paths field to every pareto-optimal path from origin to target, including those that tie with the one
+///paretoOptimalGroupSizeAndTransportShift picks for their hop count. That front bounds the enumeration: no path
+///longer than its longest one or narrower than its narrowest one can be on it, and branches it dominates are cut.
+///\param origin is the origin node
+///\param target is the target node
+///\param threads number of worker threads
+///\param timeLimit how long the enumeration may run, 0 for no limit
+///@return true if every tie was found; otherwise paths still holds at least one path for every front point
 template<class T>
-int Graph<T>::recursivePathFinderLimited(T current, T target, int currentCap, int bfsCap, int maxCapEdges) {
-    if (findVertex(current)->visited) {
-        return 0;
-    }
-    findVertex(current)->visited = true;
-    mutatingPath.push_back(current);
-    if (current == target) {
-        pair<vector<int>, int> res;
-        res.first = mutatingPath;
-        res.second = currentCap;
-        paths.insert(res);
-        findVertex(current)->visited = false;
-        mutatingPath.pop_back();
-        return 0;
+bool Graph<T>::allParetoOptimalPaths(T origin, T target, int threads, std::chrono::milliseconds timeLimit) {
+    paretoOptimalGroupSizeAndTransportShift(origin, target);
+    if (paths.empty()) return true;
+    EnumerationLimits limits;
+    limits.frontOnly = true;
+    limits.timeLimit = timeLimit;
+    int narrowest = INF;
+    int longest = 0;
+    for (int path = 0; path < paths.size(); path++) {
+        narrowest = std::min(narrowest, paths.getAmount(path));
+        limits.known.emplace_back(paths.getLength(path) - 1, paths.getAmount(path));
+        longest = std::max(longest, paths.getLength(path));
     }
-    for (auto e : findVertex(current)->adj) {
-        if (e.capacity > bfsCap && mutatingPath.size() < maxCapEdges) {
-            recursivePathFinderLimited(e.dest->info, target, std::min(currentCap, e.capacity), bfsCap, maxCapEdges);
-        }
-    }
-    mutatingPath.pop_back();
-    findVertex(current)->visited = false;
-    return 0;
+    limits.minCapacity = narrowest - 1;
+    limits.maxHops = longest - 1;
+    bool complete = enumeratePaths(origin, target, limits, threads);
+    paths = filterPathsByDominance();
+    return complete;
 }
 
 ///Filters paths on the paths field of the graph to exclude paths that are dominated by others in terms of capacity and path size
+///The ids of the paths are sorted by (size ascending, capacity descending), so no path is copied until it's kept.
+///One sweep then keeps a path when it's the widest of its size, or ties with it, and is wider than every shorter
+///path. O(P log P) instead of comparing every pair.
+///@return the paths kept, with their capacities
 template<class T>
-map<vector<int>, int> Graph<T>::filterPathsByDominance() {
-    map<vector<int>, int> filtered;
-    for (auto path : paths) {
-        bool dominated = false;
-        for (auto path2 : paths) {
-            if ((path2.first.size() < path.first.size() && path2.second >= path.second) ||
-                    (path2.second > path.second && path2.first.size() <= path.first.size())) {
-                dominated = true;
+PathStore<T> Graph<T>::filterPathsByDominance() const {
+    vector<int> order(paths.size());
+    for (int id = 0; id < paths.size(); id++) order[id] = id;
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        if (paths.getLength(a) != paths.getLength(b)) return paths.getLength(a) < paths.getLength(b);
+        return paths.getAmount(a) > paths.getAmount(b);
+    });
+    PathStore<T> filtered;
+    int widestShorter = std::numeric_limits<int>::min();  // widest capacity among the sizes already swept
+    for (size_t i = 0, j; i < order.size(); i = j) {
+        int widest = paths.getAmount(order[i]);  // of this size
+        for (j = i; j < order.size() && paths.getLength(order[j]) == paths.getLength(order[i]); j++) {
+            if (widest > widestShorter && paths.getAmount(order[j]) == widest) {
+                for (const T *node = paths.begin(order[j]); node != paths.end(order[j]); node++) filtered.push(*node);
+                filtered.commit(widest);
             }
         }
-        if (!dominated) {
-            filtered.insert(path);
-        }
+        widestShorter = std::max(widestShorter, widest);
     }
     return filtered;
 }
@@ -0,0 +1,132 @@
+///\file
+/// Bulk loader for the edge-list datasets in Tests/: a "N R" header followed by R lines "i j capacity duration"
+
+#ifndef GRAPHLOADER_H_
+#define GRAPHLOADER_H_
+
+#include <algorithm>
+#include <charconv>
+#include <climits>
+#include <chrono>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Graph.h"
+
+///Outcome of loading a dataset
+struct LoadReport {
+    int nodes = 0;          // N, from the header
+    int edges = 0;          // R, from the header, checked against the edges actually read
+    long parseMicros = 0;   // time spent reading and parsing the file
+    long buildMicros = 0;   // time spent building the graph
+    std::string error;      // why loading failed, empty on success
+};
+
+///Skips whitespace
+///\param p current position, moved past the whitespace
+///\param end end of the buffer
+///@return true if there is anything left to read
+inline bool skipSpaces(const char *&p, const char *end) {
+    while (p != end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) p++;
+    return p != end;
+}
+
+///Reads the next integer of the buffer
+///\param p current position, moved past the integer
+///\param end end of the buffer
+///\param value where the integer is stored
+///@return true if an integer was read
+inline bool scanInt(const char *&p, const char *end, int &value) {
+    if (!skipSpaces(p, end)) return false;
+    auto res = std::from_chars(p, end, value);
+    if (res.ec != std::errc()) return false;
+    p = res.ptr;
+    return true;
+}
+
+///Reads a whole file into memory with a single read
+///\param path path of the file
+///\param buffer where the contents are stored
+///@return true if the file could be read
+inline bool readWholeFile(const std::string &path, std::vector<char> &buffer) {
+    std::ifstream stream(path, std::ios::binary | std::ios::ate);
+    if (!stream) return false;
+    std::streamsize size = stream.tellg();
+    if (size < 0) return false;
+    buffer.resize(size);
+    stream.seekg(0);
+    return (bool) stream.read(buffer.data(), size);
+}
+
+///Loads an edge-list dataset into an empty graph
+///The whole file is parsed into a flat edge array first; vertices and adjacency lists are then created in bulk,
+///each adjacency list reserved from the pre-counted out-degrees
+///\param path path of the dataset
+///\param graph empty graph that receives vertices 1..N and the R edges
+///\param report receives the header counts, the parse and build times and, on failure, the reason
+///@return true if the dataset was loaded
+inline bool loadEdgeList(const std::string &path, Graph<int> &graph, LoadReport &report) {
+    using clock = std::chrono::steady_clock;
+    auto start = clock::now();
+
+    std::vector<char> buffer;
+    if (!readWholeFile(path, buffer)) {
+        report.error = "can't read " + path;
+        return false;
+    }
+    const char *p = buffer.data(), *end = p + buffer.size();
+    if (!scanInt(p, end, report.nodes) || !scanInt(p, end, report.edges) || report.nodes <= 0 || report.edges < 0
+        || report.nodes > INT_MAX - 1) {
+        report.error = "invalid \"N R\" header";
+        return false;
+    }
+    int n = report.nodes;
+    std::vector<int> raw; // 4 ints per edge: origin, destination, capacity, duration
+    // an edge line takes at least 8 bytes ("1 2 3 4\n"), so a header announcing more edges than the file can hold
+    // doesn't get to reserve memory for them
+    raw.reserve(4 * std::min((size_t) report.edges, buffer.size() / 8 + 1));
+    while (skipSpaces(p, end)) {
+        int field[4];
+        for (int &f : field) {
+            if (!scanInt(p, end, f)) {
+                report.error = "malformed edge " + std::to_string(raw.size() / 4 + 1);
+                return false;
+            }
+        }
+        if (field[0] < 1 || field[0] > n || field[1] < 1 || field[1] > n) {
+            report.error = "edge " + std::to_string(raw.size() / 4 + 1) + " has a node outside 1.." + std::to_string(n);
+            return false;
+        }
+        raw.insert(raw.end(), field, field + 4);
+    }
+    if ((int) (raw.size() / 4) != report.edges) {
+        report.error = "header announces " + std::to_string(report.edges) + " edges but the file has "
+                       + std::to_string(raw.size() / 4);
+        return false;
+    }
+    auto parsed = clock::now();
+
+    graph.setNumberNodes(n);
+    graph.setNumberEdges(report.edges);
+    // like the edges, the vertices don't get to reserve more than the file can justify: each edge line (8 bytes or
+    // more) names at most 2 of them. Vertices past the reservation are still added, just without room set aside
+    graph.reserveVertices((int) std::min((size_t) n, buffer.size() / 4 + 2));
+    std::vector<int> degree(n + 1, 0);
+    for (size_t i = 0; i < raw.size(); i += 4) degree[raw[i]]++;
+    for (int v = 1; v <= n; v++) {
+        if (!graph.addVertex(v)) {
+            report.error = "graph already has node " + std::to_string(v);
+            return false;
+        }
+        graph.reserveEdges(v, degree[v]);
+    }
+    for (size_t i = 0; i < raw.size(); i += 4)
+        graph.addEdge(raw[i], raw[i + 1], raw[i + 3], raw[i + 2], 1);
+    auto built = clock::now();
+
+    report.parseMicros = std::chrono::duration_cast<std::chrono::microseconds>(parsed - start).count();
+    report.buildMicros = std::chrono::duration_cast<std::chrono::microseconds>(built - parsed).count();
+    return true;
+}
+
+#endif /* GRAPHLOADER_H_ */
@@ -0,0 +1,282 @@
+///\file
+/// Versioned binary snapshot of a loaded graph, mapped read-only through mmap and validated without parsing
+///
+/// Layout, in native byte order, every array 4-byte aligned:
+///   SnapshotHeader
+///   int32  info[nodes]        vertex contents
+///   int32  offset[nodes + 1]  CSR offsets: the edges of vertex v are [offset[v], offset[v+1])
+///   int32  dest[edges]        destination vertex index
+///   int32  capacity[edges]
+///   int32  duration[edges]
+/// The checksum is the 64-bit FNV-1a hash of everything after the header.
+///
+/// Opening a snapshot allocates nothing per edge, but the menu and batch algorithms run on a Graph, which
+/// GraphSnapshot::toGraph still builds vertex by vertex and edge by edge. On in10 the open (map, checksum and checks)
+/// takes about 1.3ms and toGraph about 5ms, against 5ms of parsing and 8ms of building for the text file.
+
+#ifndef GRAPHSNAPSHOT_H_
+#define GRAPHSNAPSHOT_H_
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "Graph.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define SNAPSHOT_MAGIC "DAP2GRPH"
+#define SNAPSHOT_VERSION 1
+
+struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t nodes;
+    uint32_t edges;
+    uint32_t reserved;
+    uint64_t checksum;
+};
+
+///64-bit FNV-1a hash
+///\param data bytes to hash
+///\param size number of bytes
+///\param hash value to continue from, so a hash can be computed in pieces
+///@return the hash of the bytes
+inline uint64_t fnv1a(const void *data, size_t size, uint64_t hash = 14695981039346656037ull) {
+    auto bytes = static_cast<const unsigned char *>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+///@return true if the file at path starts with the snapshot magic
+inline bool isSnapshotFile(const std::string &path) {
+    char magic[8];
+    std::ifstream stream(path, std::ios::binary);
+    return stream.read(magic, sizeof(magic)) && std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) == 0;
+}
+
+///Writes a snapshot of a graph
+///\param graph the graph to save
+///\param path where to write the snapshot
+///\param error receives the reason on failure
+///@return true if the snapshot was written
+inline bool writeSnapshot(const Graph<int> &graph, const std::string &path, std::string &error) {
+    CsrGraph<int> csr(graph);
+    int n = csr.getNumVertex(), m = csr.getNumEdges();
+    std::vector<int32_t> payload;
+    payload.reserve(2 * (size_t) n + 1 + 3 * (size_t) m);
+    for (int v = 0; v < n; v++) payload.push_back(csr.getInfo(v));
+    for (int v = 0; v < n; v++) payload.push_back(csr.edgesBegin(v));
+    payload.push_back(m);
+    for (int e = 0; e < m; e++) payload.push_back(csr.getDest(e));
+    for (int e = 0; e < m; e++) payload.push_back(csr.getCapacity(e));
+    for (int e = 0; e < m; e++) payload.push_back(csr.getDuration(e));
+
+    SnapshotHeader header{};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.nodes = n;
+    header.edges = m;
+    header.checksum = fnv1a(payload.data(), payload.size() * sizeof(int32_t));
+
+    std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+    if (!stream.write(reinterpret_cast<const char *>(&header), sizeof(header))
+        || !stream.write(reinterpret_cast<const char *>(payload.data()), payload.size() * sizeof(int32_t))) {
+        error = "can't write " + path;
+        return false;
+    }
+    return true;
+}
+
+/************************* GraphSnapshot  **************************/
+
+///Read-only view of a snapshot file. The arrays point straight into the mapped file, and stay valid while it's open.
+class GraphSnapshot {
+    const char *data = nullptr;
+    size_t size = 0;
+    std::vector<char> owned; // file contents when mmap isn't available
+    const SnapshotHeader *header = nullptr;
+    const int32_t *infoArr = nullptr, *offsetArr = nullptr, *destArr = nullptr, *capacityArr = nullptr,
+            *durationArr = nullptr;
+
+    void close();
+    bool validate(std::string &error);
+
+public:
+    GraphSnapshot() = default;
+    GraphSnapshot(const GraphSnapshot &) = delete;
+    GraphSnapshot &operator=(const GraphSnapshot &) = delete;
+    ~GraphSnapshot();
+
+    bool open(const std::string &path, std::string &error);
+    int getNumVertex() const;
+    int getNumEdges() const;
+    const int32_t *info() const;
+    const int32_t *offsets() const;
+    const int32_t *dest() const;
+    const int32_t *capacity() const;
+    const int32_t *duration() const;
+    bool toGraph(Graph<int> &graph) const;
+};
+
+inline GraphSnapshot::~GraphSnapshot() {
+    close();
+}
+
+inline void GraphSnapshot::close() {
+#ifndef _WIN32
+    if (data != nullptr && owned.empty()) munmap(const_cast<char *>(data), size);
+#endif
+    owned.clear();
+    data = nullptr;
+    header = nullptr;
+    size = 0;
+}
+
+///Maps a snapshot file and checks its header, layout and checksum
+///\param path path of the snapshot
+///\param error receives the reason on failure
+///@return true if the snapshot is valid and mapped
+inline bool GraphSnapshot::open(const std::string &path, std::string &error) {
+    close();
+#ifndef _WIN32
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd == -1) {
+        error = "can't open " + path;
+        return false;
+    }
+    struct stat st{};
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void *mapped = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapped != MAP_FAILED) {
+            data = static_cast<const char *>(mapped);
+            size = st.st_size;
+        }
+    }
+    ::close(fd);
+#endif
+    if (data == nullptr) {
+        std::ifstream stream(path, std::ios::binary | std::ios::ate);
+        std::streamsize length = stream ? (std::streamsize) stream.tellg() : -1;
+        if (length <= 0) {
+            error = "can't read " + path;
+            return false;
+        }
+        owned.resize(length);
+        stream.seekg(0);
+        stream.read(owned.data(), length);
+        data = owned.data();
+        size = length;
+    }
+    if (!validate(error)) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+inline bool GraphSnapshot::validate(std::string &error) {
+    if (size < sizeof(SnapshotHeader)) {
+        error = "file too small for a snapshot header";
+        return false;
+    }
+    header = reinterpret_cast<const SnapshotHeader *>(data);
+    if (std::memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0) {
+        error = "not a graph snapshot";
+        return false;
+    }
+    if (header->version != SNAPSHOT_VERSION) {
+        error = "unsupported snapshot version " + std::to_string(header->version);
+        return false;
+    }
+    uint64_t n = header->nodes, m = header->edges;
+    if (size != sizeof(SnapshotHeader) + (2 * n + 1 + 3 * m) * sizeof(int32_t)) {
+        error = "snapshot size doesn't match its header";
+        return false;
+    }
+    const char *payload = data + sizeof(SnapshotHeader);
+    if (fnv1a(payload, size - sizeof(SnapshotHeader)) != header->checksum) {
+        error = "snapshot checksum mismatch";
+        return false;
+    }
+    infoArr = reinterpret_cast<const int32_t *>(payload);
+    offsetArr = infoArr + n;
+    destArr = offsetArr + n + 1;
+    capacityArr = destArr + m;
+    durationArr = capacityArr + m;
+    if (offsetArr[0] != 0 || (uint64_t) offsetArr[n] != m) {
+        error = "snapshot offsets are inconsistent";
+        return false;
+    }
+    for (uint64_t v = 0; v < n; v++) {
+        if (offsetArr[v] > offsetArr[v + 1]) {
+            error = "snapshot offsets are inconsistent";
+            return false;
+        }
+    }
+    for (uint64_t e = 0; e < m; e++) {
+        if (destArr[e] < 0 || (uint64_t) destArr[e] >= n) {
+            error = "snapshot edge " + std::to_string(e) + " points outside the graph";
+            return false;
+        }
+    }
+    return true;
+}
+
+inline int GraphSnapshot::getNumVertex() const {
+    return header == nullptr ? 0 : header->nodes;
+}
+
+inline int GraphSnapshot::getNumEdges() const {
+    return header == nullptr ? 0 : header->edges;
+}
+
+inline const int32_t *GraphSnapshot::info() const {
+    return infoArr;
+}
+
+inline const int32_t *GraphSnapshot::offsets() const {
+    return offsetArr;
+}
+
+inline const int32_t *GraphSnapshot::dest() const {
+    return destArr;
+}
+
+inline const int32_t *GraphSnapshot::capacity() const {
+    return capacityArr;
+}
+
+inline const int32_t *GraphSnapshot::duration() const {
+    return durationArr;
+}
+
+///Builds the pointer-based graph the menu algorithms work on, reserving each adjacency list up front.
+///This copies the whole snapshot: O(V + E), with one Vertex and one adjacency list allocated per vertex.
+///\param graph empty graph that receives the snapshot's vertices and edges
+///@return false if the graph already had one of the snapshot's vertices
+inline bool GraphSnapshot::toGraph(Graph<int> &graph) const {
+    int n = getNumVertex();
+    graph.setNumberNodes(n);
+    graph.setNumberEdges(getNumEdges());
+    graph.reserveVertices(n);
+    for (int v = 0; v < n; v++) {
+        if (!graph.addVertex(infoArr[v])) return false;
+        graph.reserveEdges(infoArr[v], offsetArr[v + 1] - offsetArr[v]);
+    }
+    for (int v = 0; v < n; v++)
+        for (int e = offsetArr[v]; e < offsetArr[v + 1]; e++)
+            graph.addEdge(infoArr[v], infoArr[destArr[e]], durationArr[e], capacityArr[e], 1);
+    return true;
+}
+
+#endif /* GRAPHSNAPSHOT_H_ */
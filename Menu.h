@@ -107,15 +107,14 @@ public:
                 "tell me what we want to find.\n"
                 "1 - The biggest possible group to go from origin to destination\n"
                 "2 - The best solutions in terms of group dimension and transporting shift count\n"
-                "3 - Return\n"
+                "3 - Every best solution in terms of group dimension and transporting shift count, ties included\n"
+                "4 - Return\n"
                 "0 - Exit\n";
-        pair<vector<int>, int> res;
-        vector<int> empty;
-        switch (intInput(0, 3)) {
+        int width;
+        switch (intInput(0, 4)) {
             case 1:
-                res.second = graph.firstAlgorithm(origin, target);
-                res.first = graph.getPath(origin, target);
-                graph.paths.insert(res);
+                width = graph.firstAlgorithm(origin, target);
+                if (width > 0) graph.paths.add(graph.getPath(origin, target), width);
                 graph.printPath(graph.paths);
                 cout << endl;
                 break;
@@ -128,6 +127,13 @@ public:
                 cout << endl;
                 break;
             case 3:
+                if (!graph.allParetoOptimalPaths(origin, target, ThreadPool::defaultThreads(), std::chrono::seconds(10))) {
+                    cout << "The search took too long, so some solutions tied with the ones below may be missing.\n";
+                }
+                graph.printPath(graph.paths);
+                cout << endl;
+                break;
+            case 4:
                 while (runInitial());
                 return 0;
             case 0:
@@ -152,12 +158,17 @@ public:
                 cout << "For this scenario, it's important to know the group size.\n"
                         "Can you tell me what is it?\n";
                 groupSize = intInput(1, INT32_MAX);
-                graph.FindPathGivenGroupSize(origin, target, groupSize);
+                cout << "How should the paths be found?\n"
+                        "1 - Shortest augmenting paths (Edmonds-Karp)\n"
+                        "2 - Widest augmenting paths first (capacity scaling)\n";
+                if (graph.FindPathGivenGroupSize(origin, target, groupSize, intInput(1, 2) == 2) < groupSize) {
+                    cout << "Couldn't find a path for the whole group. The biggest possible group's path goes as follows:\n";
+                }
                 graph.printPath(graph.paths);
                 cout << endl;
                 break;
             case 2:
-                graph.edmondKarpFlux(origin, target);
+                runMaxFlow();
                 graph.printPath(graph.paths);
                 cout << endl;
                 break;
@@ -173,6 +184,29 @@ public:
         return 0;
     }
 
+    ///This method queries the user which maximum flow algorithm to use and runs it from origin to target.
+    ///\returns the biggest possible group dimension.
+    int runMaxFlow() {
+        int threads;
+        cout << "Which algorithm should find it?\n"
+                "1 - Edmonds-Karp\n"
+                "2 - Dinic\n"
+                "3 - Push-relabel\n"
+                "4 - Parallel push-relabel\n";
+        switch (intInput(1, 4)) {
+            case 2:
+                return graph.dinicFlux(origin, target);
+            case 3:
+                return graph.pushRelabelFlux(origin, target);
+            case 4:
+                cout << "How many threads should it use? (0 uses every hardware thread)\n";
+                threads = intInput(0, 1024);
+                return graph.parallelPushRelabelFlux(origin, target, threads == 0 ? ThreadPool::defaultThreads() : threads);
+            default:
+                return graph.edmondKarpFlux(origin, target);
+        }
+    }
+
     ///This method essentially queries the user if we want to call any algorithm that depended on previous algorithm calls.
     ///\returns an integer representing either the menu flow has ended (0) or not (1).
     int runAfterSecond() {
@@ -182,7 +216,8 @@ public:
                 "2 - Tell the soonest possible time the group would reunite in destination (2.4)\n"
                 "3 - Assuming everybody leaves from the same place and time, what would "
                 "be the greatest waiting time possible (2.5)\n"
-                "4 - Return\n"
+                "4 - Critical path analysis of the group's paths\n"
+                "5 - Return\n"
                 "0 - Exit\n";
         switch (intInput(0, 5)) {
             case 1:
@@ -201,6 +236,10 @@ public:
                 cout << endl;
                 break;
             case 4:
+                printCriticalPath(graph.criticalPath(origin, target));
+                cout << endl;
+                break;
+            case 5:
                 while (runSecond());
                 return 0;
             case 0:
@@ -208,6 +247,30 @@ public:
         }
         return 1;
     }
+
+    ///This method prints the timing of every stop and every vehicle used by the group, and which vehicles are critical.
+    ///\param cpm the critical path analysis to print
+    static void printCriticalPath(const CriticalPath<int> &cpm) {
+        if (cpm.edges.empty()) {
+            cout << "Seems like no group goes through the network!\n";
+            return;
+        }
+        cout << "The whole group arrives after " << cpm.duration << " minutes.\n"
+                "Stop: earliest, latest, total float, free float\n";
+        for (const CpmNode<int> &node : cpm.nodes) {
+            if (!node.onNetwork) continue;
+            cout << node.info << ": " << node.earliest << ", " << node.latest << ", " << node.totalFloat << ", "
+                 << node.freeFloat << '\n';
+        }
+        cout << "Vehicle: earliest start, latest start, total float, free float\n";
+        for (const CpmEdge<int> &edge : cpm.edges) {
+            cout << edge.from << " -> " << edge.to << ": " << edge.earliestStart << ", " << edge.latestStart << ", "
+                 << edge.totalFloat << ", " << edge.freeFloat << (edge.critical ? " (critical)" : "") << '\n';
+        }
+        cout << "Critical vehicles:";
+        for (int e : cpm.criticalEdges) cout << ' ' << cpm.edges[e].from << "->" << cpm.edges[e].to;
+        cout << '\n';
+    }
 };
 
 #endif //PROJ2_MENU_H
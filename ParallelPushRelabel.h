@@ -0,0 +1,201 @@
+///\file
+/// Multithreaded push-relabel maximum flow over a CsrGraph
+
+#ifndef PARALLELPUSHRELABEL_H_
+#define PARALLELPUSHRELABEL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <vector>
+#include "CsrGraph.h"
+#include "ThreadPool.h"
+
+/************************* ParallelPushRelabel  **************************/
+
+///Lock-free push-relabel (Hong's asynchronous variant): every worker discharges its own active vertices
+///concurrently, moving flow with atomic updates of flux and excess, and relabels a vertex to one more than its
+///lowest residual neighbour. Work is done in rounds; between rounds, once n relabels have piled up, labels are
+///reset to exact residual distances by a level-synchronous parallel BFS (distance to t, or n + distance to s).
+///Each vertex is owned by a single worker per round, so only its owner lowers its excess or changes its label.
+template <class T>
+class ParallelPushRelabel {
+    CsrGraph<T> &graph;
+    ThreadPool pool;
+    int n = 0, s = 0, t = 0;
+    std::vector<std::atomic<int>> flux;
+    std::vector<std::atomic<int>> excess;
+    std::vector<std::atomic<int>> label;
+    std::vector<std::atomic<char>> queued;   // already in the active list of the current or next round
+    std::vector<int> active;
+    std::vector<std::vector<int>> local;     // per worker: vertices for the next round, or the next BFS frontier
+    std::atomic<size_t> cursor{0};
+    std::atomic<int> relabels{0};
+
+    int residual(int arc) const;
+    void push(int u, int arc, int amount, int worker);
+    void discharge(int u, int worker);
+    void labelFrom(int root, int base);
+    void globalRelabel();
+    void gatherLocal(std::vector<int> &into);
+
+public:
+    ParallelPushRelabel(CsrGraph<T> &graph, int threads);
+    int run(int s, int t);
+};
+
+///\param graph graph to compute the flow on; its flux is overwritten by run
+///\param threads number of worker threads
+template <class T>
+ParallelPushRelabel<T>::ParallelPushRelabel(CsrGraph<T> &graph, int threads)
+        : graph(graph), pool(threads), local(pool.size()) {}
+
+template <class T>
+int ParallelPushRelabel<T>::residual(int arc) const {
+    return arc >= 0 ? graph.capacity[arc] - flux[arc].load() : flux[~arc].load();
+}
+
+///Moves amount of u's excess along arc, queueing the vertex at its head for the next round if it just became active
+template <class T>
+void ParallelPushRelabel<T>::push(int u, int arc, int amount, int worker) {
+    if (arc >= 0) flux[arc].fetch_add(amount);
+    else flux[~arc].fetch_sub(amount);
+    int w = graph.arcHead(arc);
+    excess[u].fetch_sub(amount);
+    if (excess[w].fetch_add(amount) == 0 && w != s && w != t && !queued[w].exchange(1))
+        local[worker].push_back(w);
+}
+
+///Discharges u: pushes to its lowest residual neighbour while that one is lower, relabels otherwise.
+///Only the owner of u lowers excess[u] or writes label[u], so values read here are safe lower bounds even
+///while other workers push into u or change the flux of the arcs it shares with them.
+template <class T>
+void ParallelPushRelabel<T>::discharge(int u, int worker) {
+    while (excess[u].load() > 0) {
+        int best = 0, bestLabel = std::numeric_limits<int>::max(); // arcs can be negative: "none" is bestLabel
+        for (int i = 0; i < graph.arcCount(u); i++) {
+            int arc = graph.arcAt(u, i);
+            if (residual(arc) > 0) {
+                int h = label[graph.arcHead(arc)].load(std::memory_order_relaxed);
+                if (h < bestLabel) {
+                    bestLabel = h;
+                    best = arc;
+                }
+            }
+        }
+        if (bestLabel == std::numeric_limits<int>::max()) return;
+        if (label[u].load(std::memory_order_relaxed) > bestLabel) {
+            push(u, best, std::min(excess[u].load(), residual(best)), worker);
+        } else {
+            label[u].store(bestLabel + 1, std::memory_order_relaxed);
+            relabels.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+///Moves every worker's list into one vector
+template <class T>
+void ParallelPushRelabel<T>::gatherLocal(std::vector<int> &into) {
+    into.clear();
+    for (std::vector<int> &list : local) {
+        into.insert(into.end(), list.begin(), list.end());
+        list.clear();
+    }
+}
+
+///Level-synchronous parallel BFS backwards over the residual arcs: every unlabelled vertex that reaches root
+///gets base plus its distance to root. Small frontiers are expanded on the calling thread.
+template <class T>
+void ParallelPushRelabel<T>::labelFrom(int root, int base) {
+    const int unlabelled = 2 * n;
+    std::vector<int> frontier{root};
+    label[root].store(base);
+    for (int level = base + 1; !frontier.empty(); level++) {
+        auto expand = [&](int v, int worker) {
+            for (int i = 0; i < graph.arcCount(v); i++) {
+                int arc = graph.arcAt(v, i), w = graph.arcHead(arc);
+                int expected = unlabelled;
+                // w reaches v through the reverse of arc
+                if (label[w].load(std::memory_order_relaxed) == unlabelled && residual(~arc) > 0
+                    && label[w].compare_exchange_strong(expected, level))
+                    local[worker].push_back(w);
+            }
+        };
+        if (frontier.size() < 256 || pool.size() == 1) {
+            for (int v : frontier) expand(v, 0);
+        } else {
+            cursor = 0;
+            pool.runOnAll([&](int worker) {
+                for (size_t i; (i = cursor.fetch_add(64)) < frontier.size();)
+                    for (size_t j = i; j < std::min(i + 64, frontier.size()); j++) expand(frontier[j], worker);
+            });
+        }
+        gatherLocal(frontier);
+    }
+}
+
+///Sets every label to its exact value: distance to t, n + distance to s for vertices cut off from t,
+///2n for vertices that reach neither
+template <class T>
+void ParallelPushRelabel<T>::globalRelabel() {
+    for (int v = 0; v < n; v++) label[v].store(2 * n, std::memory_order_relaxed);
+    label[s].store(n);
+    labelFrom(t, 0);
+    label[s].store(2 * n);
+    labelFrom(s, n);
+    relabels = 0;
+}
+
+///Computes the maximum flow from s to t and stores it in the graph's flux, with its decomposition in paths
+///\param s index of the start vertex
+///\param t index of the target vertex
+///@return the maximum flow, 0 if s is t
+template <class T>
+int ParallelPushRelabel<T>::run(int s, int t) {
+    if (s == t) {
+        // s would both drain and feed the active list, which then never empties
+        graph.zeroFlux();
+        graph.paths.clear();
+        return 0;
+    }
+    this->s = s;
+    this->t = t;
+    n = graph.getNumVertex();
+    int m = graph.getNumEdges();
+    flux = std::vector<std::atomic<int>>(m);
+    excess = std::vector<std::atomic<int>>(n);
+    label = std::vector<std::atomic<int>>(n);
+    queued = std::vector<std::atomic<char>>(n);
+    for (int e = 0; e < m; e++) flux[e].store(0, std::memory_order_relaxed);
+    for (int v = 0; v < n; v++) {
+        excess[v].store(0, std::memory_order_relaxed);
+        queued[v].store(0, std::memory_order_relaxed);
+    }
+
+    active.clear();
+    for (int e = graph.edgesBegin(s); e < graph.edgesEnd(s); e++) {
+        if (graph.capacity[e] > 0) push(s, e, graph.capacity[e], 0);
+    }
+    gatherLocal(active);
+    globalRelabel();
+
+    while (!active.empty()) {
+        if (relabels.load() >= n) globalRelabel();
+        cursor = 0;
+        pool.runOnAll([&](int worker) {
+            for (size_t i; (i = cursor.fetch_add(1)) < active.size();) {
+                int u = active[i];
+                queued[u].store(0);
+                discharge(u, worker);
+                if (excess[u].load() > 0 && !queued[u].exchange(1)) local[worker].push_back(u);
+            }
+        });
+        gatherLocal(active);
+    }
+
+    for (int e = 0; e < m; e++) graph.flux[e] = flux[e].load(std::memory_order_relaxed);
+    graph.decomposeFlux(s, t);
+    return excess[t].load();
+}
+
+#endif /* PARALLELPUSHRELABEL_H_ */
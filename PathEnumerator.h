@@ -0,0 +1,263 @@
+///\file
+/// Bounded, pruned and multithreaded enumeration of the simple paths between two vertices of a CsrGraph
+
+#ifndef PATHENUMERATOR_H_
+#define PATHENUMERATOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "CsrGraph.h"
+#include "PathStore.h"
+#include "ThreadPool.h"
+
+///Which paths to enumerate and when to give up
+struct EnumerationLimits {
+    int minCapacity = 0;        // only edges with a bigger capacity are followed
+    int maxHops = -1;           // longest path, in edges; -1 for no bound but the vertex count
+    bool frontOnly = false;     // skip branches that can only give paths dominated by ones already found
+    std::vector<std::pair<int, int>> known;     // frontOnly: (hops, width) of paths known to exist beforehand
+    size_t maxResults = 0;      // stop after finding that many paths, 0 for no limit
+    std::chrono::milliseconds timeLimit{0};     // stop searching after that long, 0 for no limit
+    const std::atomic<bool> *cancel = nullptr;  // stop as soon as it's set, if given
+};
+
+/************************* PathEnumerator  **************************/
+
+///Depth-first enumeration of the simple paths from s to t, with an explicit stack instead of recursion.
+///A branch is cut as soon as the hops it has taken plus the hop distance of its head to t (a reverse BFS, done
+///once) exceed maxHops. With frontOnly, a branch is also cut when every outcome it can still have is dominated by a
+///path already found: its width can't end above the widest path from its head to t, and ending above a known width
+///means only using edges wider than it, so the hop distance over those edges bounds its length.
+///The subtrees of the origin's edges are handed out to the workers of a thread pool; each worker keeps its own
+///stack and result buffer, merged into paths at the end, and the only shared writes are the stop flag, the
+///result count and, with frontOnly, the widest width found within each hop count.
+template <class T>
+class PathEnumerator {
+    struct Frame {
+        int v;      // vertex
+        int next;   // next outgoing edge of v to try
+        int width;  // bottleneck of the path up to v
+    };
+
+    struct Worker {
+        std::vector<Frame> stack;
+        std::vector<char> onPath;
+        std::vector<int> nodes;                    // vertices of the paths found, one after the other
+        std::vector<std::pair<size_t, int>> found; // end of each path in nodes, and its width
+    };
+
+    const CsrGraph<T> &graph;
+    ThreadPool pool;
+    std::vector<Worker> workers;
+    int n = 0, s = 0, t = 0, maxHops = 0;
+    EnumerationLimits limits;
+    std::vector<int> thresholds;             // minCapacity, then the widths of the known paths above it, ascending
+    std::vector<int> hopsTo;                 // [j * n + v]: fewest edges wider than thresholds[j] from v to t, or -1
+    std::vector<int> widthTo;                // widest path from each vertex to t
+    std::vector<std::atomic<int>> widest;    // frontOnly: widest path found with at most h edges
+    std::atomic<size_t> cursor{0};           // next edge of the origin to explore
+    std::atomic<size_t> count{0};            // paths found
+    std::atomic<bool> stop{false};
+    std::chrono::steady_clock::time_point deadline;
+
+    void distancesToTarget();
+    bool dominated(int hops, int width) const;
+    bool wanted(int v, int hops, int width) const;
+    void record(Worker &worker, int hops, int width);
+    bool interrupted(long long &steps);
+    void explore(Worker &worker, int edge);
+
+public:
+    PathStore<T> paths;   // every path found and its width
+
+    PathEnumerator(const CsrGraph<T> &graph, int threads);
+    bool run(int s, int t, const EnumerationLimits &limits);
+};
+
+///\param graph graph whose paths are enumerated
+///\param threads number of worker threads
+template <class T>
+PathEnumerator<T>::PathEnumerator(const CsrGraph<T> &graph, int threads)
+        : graph(graph), pool(threads), workers(pool.size()) {}
+
+///Reverse BFSs from t over the edges wider than each threshold, and reverse widest path from t
+template <class T>
+void PathEnumerator<T>::distancesToTarget() {
+    thresholds.assign(1, limits.minCapacity);
+    if (limits.frontOnly) {
+        for (const std::pair<int, int> &path : limits.known) {
+            if (path.second > limits.minCapacity) thresholds.push_back(path.second);
+        }
+        std::sort(thresholds.begin(), thresholds.end());
+        thresholds.erase(std::unique(thresholds.begin(), thresholds.end()), thresholds.end());
+    }
+    hopsTo.assign(thresholds.size() * n, -1);
+    widthTo.assign(n, 0);
+    std::vector<int> queue;
+    queue.reserve(n);
+    for (size_t j = 0; j < thresholds.size(); j++) {
+        int *hops = &hopsTo[j * n];
+        queue.assign(1, t);
+        hops[t] = 0;
+        for (size_t head = 0; head < queue.size(); head++) {
+            int w = queue[head];
+            for (int i = graph.inOffset[w]; i < graph.inOffset[w + 1]; i++) {
+                int e = graph.inEdge[i], v = graph.source[e];
+                if (graph.capacity[e] > thresholds[j] && hops[v] == -1) {
+                    hops[v] = hops[w] + 1;
+                    queue.push_back(v);
+                }
+            }
+        }
+    }
+    std::priority_queue<std::pair<int, int>> heap;  // (width, vertex), widest first, stale entries skipped
+    widthTo[t] = CsrGraph<T>::INFTY;
+    heap.emplace(widthTo[t], t);
+    while (!heap.empty()) {
+        std::pair<int, int> top = heap.top();
+        heap.pop();
+        int w = top.second;
+        if (top.first != widthTo[w]) continue;
+        for (int i = graph.inOffset[w]; i < graph.inOffset[w + 1]; i++) {
+            int e = graph.inEdge[i], v = graph.source[e];
+            int through = std::min(widthTo[w], graph.capacity[e]);
+            if (graph.capacity[e] > limits.minCapacity && through > widthTo[v]) {
+                widthTo[v] = through;
+                heap.emplace(through, v);
+            }
+        }
+    }
+}
+
+///@return true if a path found so far is shorter and at least as wide, or as short and wider
+template <class T>
+bool PathEnumerator<T>::dominated(int hops, int width) const {
+    return widest[hops].load(std::memory_order_relaxed) > width ||
+           (hops > 0 && widest[hops - 1].load(std::memory_order_relaxed) >= width);
+}
+
+///@return whether a branch at v, after the given hops and with the given width, can still give a wanted path
+template <class T>
+bool PathEnumerator<T>::wanted(int v, int hops, int width) const {
+    int bound = std::min(width, widthTo[v]);
+    // outcomes wider than thresholds[j] and at most thresholds[j + 1] wide
+    for (size_t j = 0; j < thresholds.size() && thresholds[j] < bound; j++) {
+        int rest = hopsTo[j * n + v];
+        if (rest == -1 || hops + rest > maxHops) return false;  // only grows with j
+        if (!limits.frontOnly) return true;
+        int top = j + 1 < thresholds.size() ? std::min(bound, thresholds[j + 1]) : bound;
+        if (!dominated(hops + rest, top)) return true;
+    }
+    return false;
+}
+
+///Stores the path on the worker's stack, which ends at t, and lets the other workers prune against it
+template <class T>
+void PathEnumerator<T>::record(Worker &worker, int hops, int width) {
+    if (limits.frontOnly && dominated(hops, width)) return;
+    if (limits.maxResults > 0 && count.fetch_add(1) >= limits.maxResults) {
+        stop = true;
+        return;
+    }
+    if (limits.frontOnly) {
+        for (int h = hops; h <= maxHops; h++) {
+            int seen = widest[h].load(std::memory_order_relaxed);
+            while (seen < width && !widest[h].compare_exchange_weak(seen, width, std::memory_order_relaxed));
+        }
+    }
+    worker.nodes.push_back(s);
+    for (const Frame &frame : worker.stack) worker.nodes.push_back(frame.v);
+    worker.found.emplace_back(worker.nodes.size(), width);
+}
+
+///@return true once the enumeration has to end early; the clock is only read every 1024 steps
+template <class T>
+bool PathEnumerator<T>::interrupted(long long &steps) {
+    if (stop.load(std::memory_order_relaxed)) return true;
+    if (limits.cancel != nullptr && limits.cancel->load(std::memory_order_relaxed)) stop = true;
+    else if (limits.timeLimit.count() > 0 && (++steps & 1023) == 0 && std::chrono::steady_clock::now() > deadline)
+        stop = true;
+    return stop.load(std::memory_order_relaxed);
+}
+
+///Enumerates the paths starting with the given edge of the origin
+template <class T>
+void PathEnumerator<T>::explore(Worker &worker, int edge) {
+    long long steps = 0;
+    std::vector<Frame> &stack = worker.stack;
+    // pushes the head of e if a path through it can still be wanted, recording the path if it's t
+    auto advance = [&](int e, int width) {
+        int w = graph.dest[e];
+        width = std::min(width, graph.capacity[e]);
+        int hops = stack.size() + 1;
+        if (graph.capacity[e] <= limits.minCapacity || worker.onPath[w] || !wanted(w, hops, width)) return;
+        stack.push_back({w, graph.offset[w], width});
+        if (w == t) {
+            record(worker, hops, width);
+            stack.pop_back();
+            return;
+        }
+        worker.onPath[w] = 1;
+    };
+    advance(edge, CsrGraph<T>::INFTY);
+    while (!stack.empty() && !interrupted(steps)) {
+        Frame &top = stack.back();
+        if (top.next == graph.offset[top.v + 1]) {
+            worker.onPath[top.v] = 0;
+            stack.pop_back();
+            continue;
+        }
+        advance(top.next++, top.width);
+    }
+    for (const Frame &frame : stack) worker.onPath[frame.v] = 0;
+    stack.clear();
+}
+
+///Enumerates the simple paths from s to t allowed by the limits, into paths
+///\param s position of the origin
+///\param t position of the target
+///@return true if every such path was found, false if a limit or the cancel flag stopped the search
+template <class T>
+bool PathEnumerator<T>::run(int s, int t, const EnumerationLimits &limits) {
+    this->s = s;
+    this->t = t;
+    this->limits = limits;
+    n = graph.getNumVertex();
+    maxHops = limits.maxHops < 0 ? n - 1 : std::min(limits.maxHops, n - 1);
+    paths.clear();
+    if (s == t) return true;
+    deadline = std::chrono::steady_clock::now() + limits.timeLimit;
+    distancesToTarget();
+    widest = std::vector<std::atomic<int>>(maxHops + 1);
+    for (std::atomic<int> &w : widest) w = CsrGraph<T>::NINFTY;
+    for (const std::pair<int, int> &path : limits.known) {
+        for (int h = std::max(path.first, 0); h <= maxHops; h++) widest[h] = std::max(widest[h].load(), path.second);
+    }
+    cursor = graph.offset[s];
+    count = 0;
+    stop = false;
+    pool.runOnAll([this](int id) {
+        Worker &worker = workers[id];
+        worker.onPath.assign(n, 0);
+        worker.onPath[this->s] = 1;
+        worker.nodes.clear();
+        worker.found.clear();
+        for (size_t e = cursor++; e < (size_t) graph.offset[this->s + 1] && !stop; e = cursor++) explore(worker, e);
+    });
+    for (Worker &worker : workers) {
+        size_t begin = 0;
+        for (const std::pair<size_t, int> &path : worker.found) {
+            for (size_t i = begin; i < path.first; i++) paths.push(graph.info[worker.nodes[i]]);
+            // parallel edges give the same vertices again, the widest of them counts
+            paths.commitMax(path.second);
+            begin = path.first;
+        }
+    }
+    return !stop;
+}
+
+#endif /* PATHENUMERATOR_H_ */
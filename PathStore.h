@@ -0,0 +1,226 @@
+///\file
+/// Flat store of paths with an amount (people, flow or capacity) each
+
+#ifndef PATHSTORE_H_
+#define PATHSTORE_H_
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+/************************* PathStore  **************************/
+
+///Set of paths, each with an amount, kept in a few contiguous arrays instead of one heap vector per path.
+///The vertices of every path live back to back in a single buffer, path i spanning [offsets[i], offsets[i+1]).
+///A path is built in place, vertex by vertex, after the stored ones and then committed: if an equal path is
+///already stored, found through an open-addressing table of hashes, the amount is added to it and the new copy
+///is dropped, or, for amounts that are widths rather than quantities, the bigger one is kept. Paths are
+///identified by their position, in the order they were first committed.
+template <class T>
+class PathStore {
+    std::vector<T> nodes;          // vertices of every stored path, followed by those of the open one
+    std::vector<size_t> offsets;   // start of each path in nodes, plus the start of the open one
+    std::vector<size_t> hashes;    // of each path
+    std::vector<int> amounts;      // of each path
+    std::vector<int> slots;        // hash table of path ids, -1 where empty; its size is 0 or a power of two
+
+    size_t hashOpen() const;
+    bool equalsOpen(int id) const;
+    void grow();
+    int close(int amount, bool widest);
+
+public:
+    PathStore();
+    int size() const;
+    bool empty() const;
+    void clear();
+
+    void push(const T &node);
+    void reverseOpen();
+    int commit(int amount);
+    int commitMax(int amount);
+    int add(const std::vector<T> &path, int amount);
+    void add(const PathStore<T> &other);
+    void addMax(const PathStore<T> &other);
+
+    const T *begin(int id) const;
+    const T *end(int id) const;
+    int getLength(int id) const;
+    std::vector<T> getPath(int id) const;
+    int getAmount(int id) const;
+    void setAmount(int id, int amount);
+    std::vector<int> lexicographicOrder() const;
+};
+
+template <class T>
+PathStore<T>::PathStore() : offsets(1, 0) {}
+
+///@return number of paths stored
+template <class T>
+int PathStore<T>::size() const {
+    return amounts.size();
+}
+
+template <class T>
+bool PathStore<T>::empty() const {
+    return amounts.empty();
+}
+
+///Removes every path, and the open one, keeping the memory for the next ones
+template <class T>
+void PathStore<T>::clear() {
+    nodes.clear();
+    offsets.assign(1, 0);
+    hashes.clear();
+    amounts.clear();
+    std::fill(slots.begin(), slots.end(), -1);
+}
+
+///Appends a vertex to the open path
+template <class T>
+void PathStore<T>::push(const T &node) {
+    nodes.push_back(node);
+}
+
+///Reverses the open path, for paths built walking back from their end
+template <class T>
+void PathStore<T>::reverseOpen() {
+    std::reverse(nodes.begin() + offsets.back(), nodes.end());
+}
+
+template <class T>
+size_t PathStore<T>::hashOpen() const {
+    size_t h = 14695981039346656037ull;
+    for (size_t i = offsets.back(); i < nodes.size(); i++) h = (h ^ std::hash<T>()(nodes[i])) * 1099511628211ull;
+    return h;
+}
+
+template <class T>
+bool PathStore<T>::equalsOpen(int id) const {
+    size_t length = nodes.size() - offsets.back();
+    return (size_t) getLength(id) == length && std::equal(begin(id), end(id), nodes.begin() + offsets.back());
+}
+
+///Doubles the hash table, keeping the load under one half
+template <class T>
+void PathStore<T>::grow() {
+    slots.assign(slots.empty() ? 16 : 2 * slots.size(), -1);
+    size_t mask = slots.size() - 1;
+    for (int id = 0; id < size(); id++) {
+        size_t i = hashes[id] & mask;
+        while (slots[i] != -1) i = (i + 1) & mask;
+        slots[i] = id;
+    }
+}
+
+///Closes the open path, storing it with amount unless an equal path is stored already
+///\param widest whether that path then keeps the bigger amount, instead of the sum
+///@return id of the path
+template <class T>
+int PathStore<T>::close(int amount, bool widest) {
+    size_t h = hashOpen();
+    size_t mask = slots.size() - 1;
+    size_t i = h & mask;
+    for (; !slots.empty() && slots[i] != -1; i = (i + 1) & mask) {
+        int id = slots[i];
+        if (hashes[id] == h && equalsOpen(id)) {
+            nodes.resize(offsets.back());
+            amounts[id] = widest ? std::max(amounts[id], amount) : amounts[id] + amount;
+            return id;
+        }
+    }
+    int id = size();
+    offsets.push_back(nodes.size());
+    hashes.push_back(h);
+    amounts.push_back(amount);
+    if (2 * (size_t) size() > slots.size()) grow();
+    else slots[i] = id;
+    return id;
+}
+
+///Closes the open path: adds amount to the equal stored path if there's one, otherwise stores it with amount
+///@return id of the path
+template <class T>
+int PathStore<T>::commit(int amount) {
+    return close(amount, false);
+}
+
+///Closes the open path: raises the equal stored path's amount to amount if there's one, otherwise stores it
+///@return id of the path
+template <class T>
+int PathStore<T>::commitMax(int amount) {
+    return close(amount, true);
+}
+
+///Adds amount to path, storing it if it isn't yet
+///@return id of the path
+template <class T>
+int PathStore<T>::add(const std::vector<T> &path, int amount) {
+    nodes.insert(nodes.end(), path.begin(), path.end());
+    return commit(amount);
+}
+
+///Adds every path of other with its amount
+template <class T>
+void PathStore<T>::add(const PathStore<T> &other) {
+    for (int id = 0; id < other.size(); id++) {
+        nodes.insert(nodes.end(), other.begin(id), other.end(id));
+        commit(other.getAmount(id));
+    }
+}
+
+///Adds every path of other, keeping the bigger amount of the paths stored in both
+template <class T>
+void PathStore<T>::addMax(const PathStore<T> &other) {
+    for (int id = 0; id < other.size(); id++) {
+        nodes.insert(nodes.end(), other.begin(id), other.end(id));
+        commitMax(other.getAmount(id));
+    }
+}
+
+///@return pointer to the first vertex of a path
+template <class T>
+const T *PathStore<T>::begin(int id) const {
+    return nodes.data() + offsets[id];
+}
+
+///@return pointer past the last vertex of a path
+template <class T>
+const T *PathStore<T>::end(int id) const {
+    return nodes.data() + offsets[id + 1];
+}
+
+///@return number of vertices of a path
+template <class T>
+int PathStore<T>::getLength(int id) const {
+    return offsets[id + 1] - offsets[id];
+}
+
+///@return a copy of a path
+template <class T>
+std::vector<T> PathStore<T>::getPath(int id) const {
+    return std::vector<T>(begin(id), end(id));
+}
+
+template <class T>
+int PathStore<T>::getAmount(int id) const {
+    return amounts[id];
+}
+
+template <class T>
+void PathStore<T>::setAmount(int id, int amount) {
+    amounts[id] = amount;
+}
+
+///@return the ids of the paths, sorted by comparing the paths lexicographically
+template <class T>
+std::vector<int> PathStore<T>::lexicographicOrder() const {
+    std::vector<int> order(size());
+    for (int id = 0; id < size(); id++) order[id] = id;
+    std::sort(order.begin(), order.end(), [this](int a, int b) {
+        return std::lexicographical_compare(begin(a), end(a), begin(b), end(b));
+    });
+    return order;
+}
+
+#endif /* PATHSTORE_H_ */
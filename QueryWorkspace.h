@@ -0,0 +1,185 @@
+///\file
+/// Per-thread scratch space for the read-only queries, run on a CsrGraph shared by every thread
+
+#ifndef QUERYWORKSPACE_H_
+#define QUERYWORKSPACE_H_
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "CsrGraph.h"
+#include "DaryHeap.h"
+#include "DijkstraQueues.h"
+
+#ifndef DIJKSTRA_QUEUE
+#define DIJKSTRA_QUEUE RadixHeapQueue
+#endif
+
+/************************* QueryWorkspace  **************************/
+
+///Widest path and shortest path queries on a graph that is never written to. Everything a query writes lives in
+///the workspace and is reused by the next query, so each thread keeps one workspace and any number of threads can
+///query the same CsrGraph at once.
+///The queries make the same choices as Graph::firstAlgorithm and Graph::dijkstraShortestPath, visiting vertices and
+///edges in the same order, so they give the same widths, distances and paths, ties included.
+template <class T>
+class QueryWorkspace {
+    const CsrGraph<T> &graph;
+    int maxCapacity = 0;          // largest edge capacity
+    int maxDuration = 0;          // largest edge duration
+    std::vector<int> dist;
+    std::vector<int> cap;
+    std::vector<int> pred;        // vertex each vertex was reached from, -1 for the start and unreached ones
+    std::vector<char> settled;    // Dijkstra: vertices whose distance is final
+    std::vector<std::vector<int>> widthBuckets;    // bucket queue of the widest path, indexed by width
+    DaryHeap<std::pair<int, int>> heap; // widest path queue when capacities are too big for buckets: (-width, widened)
+    int widened = 0;              // widenings so far in the heap, which break ties between equal widths
+    DIJKSTRA_QUEUE queue;
+
+    void reset();
+    void relaxWidths(int v, bool buckets);
+
+public:
+    explicit QueryWorkspace(const CsrGraph<T> &graph);
+    int widestPath(int s, int t);
+    int widestPath(int s, int t, bool buckets);
+    int shortestPath(int s, int t);
+    int getCap(int v) const;
+    int getPred(int v) const;
+    std::vector<T> getPath(int s, int t) const;
+};
+
+///\param graph graph the queries run on, which must outlive the workspace and not change while it's used
+template <class T>
+QueryWorkspace<T>::QueryWorkspace(const CsrGraph<T> &graph) : graph(graph) {
+    int n = graph.getNumVertex();
+    for (int e = 0; e < graph.getNumEdges(); e++) {
+        maxCapacity = std::max(maxCapacity, graph.getCapacity(e));
+        maxDuration = std::max(maxDuration, graph.getDuration(e));
+    }
+    dist.resize(n);
+    cap.resize(n);
+    pred.resize(n);
+    settled.resize(n);
+}
+
+template <class T>
+void QueryWorkspace<T>::reset() {
+    std::fill(pred.begin(), pred.end(), -1);
+    std::fill(settled.begin(), settled.end(), 0);
+}
+
+///Widens the heads of v's edges that get wider through v, queueing them
+template <class T>
+void QueryWorkspace<T>::relaxWidths(int v, bool buckets) {
+    for (int e = graph.edgesBegin(v), end = graph.edgesEnd(v); e < end; e++) {
+        int w = graph.getDest(e);
+        int through = std::min(cap[v], graph.getCapacity(e));
+        if (through > cap[w]) {
+            cap[w] = through;
+            pred[w] = v;
+            if (buckets) widthBuckets[through].push_back(w);
+            else if (heap.hasKey(w)) heap.decreaseKey(w, {-through, widened++});
+            else heap.insert(w, {-through, widened++});
+        }
+    }
+}
+
+///Widest path from s, with a bucket queue when the largest capacity isn't bigger than the graph and a heap otherwise.
+///Each bucket is emptied first in, first out and the heap pops equal widths in the order they were reached, so
+///both pick the same paths.
+///\param s index of the start vertex
+///\param t index of the target vertex
+///@return the width of the widest path from s to t, 0 if t can't be reached
+template <class T>
+int QueryWorkspace<T>::widestPath(int s, int t) {
+    return widestPath(s, t, (size_t) maxCapacity <= (size_t) graph.getNumVertex() + graph.getNumEdges());
+}
+
+///Widest path from s with the queue chosen by the caller, to compare the two
+///\param s index of the start vertex
+///\param t index of the target vertex
+///\param buckets whether to use the bucket queue, which takes one bucket per capacity up to the largest, or the heap
+///@return the width of the widest path from s to t, 0 if t can't be reached
+template <class T>
+int QueryWorkspace<T>::widestPath(int s, int t, bool buckets) {
+    reset();
+    std::fill(cap.begin(), cap.end(), 0);
+    cap[s] = CsrGraph<T>::INFTY;
+    if (buckets) {
+        if (widthBuckets.size() < (size_t) maxCapacity + 1) widthBuckets.resize(maxCapacity + 1);
+        relaxWidths(s, true);
+        for (int c = maxCapacity; c > 0; c--) {
+            std::vector<int> &bucket = widthBuckets[c];
+            for (size_t i = 0; i < bucket.size(); i++) {
+                int v = bucket[i];
+                if (cap[v] == c && v != s) relaxWidths(v, true);
+            }
+            bucket.clear();
+        }
+    } else {
+        heap.reset(graph.getNumVertex());
+        widened = 0;
+        heap.insert(s, {-CsrGraph<T>::INFTY, widened++});
+        while (heap.getSize() > 0) relaxWidths(heap.removeMin(), false);
+    }
+    return s != t && pred[t] == -1 ? 0 : cap[t];
+}
+
+///Dijkstra's algorithm from s, using edge duration as weight; among predecessors giving the same distance over a
+///positive duration, the one with the smallest index is kept
+///\param s index of the start vertex
+///\param t index of the target vertex
+///@return the duration of the shortest path from s to t, CsrGraph::INFTY if t can't be reached
+template <class T>
+int QueryWorkspace<T>::shortestPath(int s, int t) {
+    reset();
+    std::fill(dist.begin(), dist.end(), CsrGraph<T>::INFTY);
+    dist[s] = 0;
+    queue.reset(graph.getNumVertex(), maxDuration);
+    queue.push(s, 0);
+    while (!queue.empty()) {
+        int v = queue.pop();
+        if (settled[v]) continue;
+        settled[v] = 1;
+        for (int e = graph.edgesBegin(v), end = graph.edgesEnd(v); e < end; e++) {
+            int w = graph.getDest(e), d = dist[v] + graph.getDuration(e);
+            if (d < dist[w]) {
+                dist[w] = d;
+                pred[w] = v;
+                queue.push(w, d);
+            } else if (d == dist[w] && graph.getDuration(e) > 0 && v < pred[w]) {
+                pred[w] = v;
+            }
+        }
+    }
+    return dist[t];
+}
+
+///@return width of v after the last widest path query, 0 if it wasn't reached
+template <class T>
+int QueryWorkspace<T>::getCap(int v) const {
+    return cap[v];
+}
+
+///@return vertex v was reached from in the last query, -1 for its start and the vertices it didn't reach
+template <class T>
+int QueryWorkspace<T>::getPred(int v) const {
+    return pred[v];
+}
+
+///Steps back from t through the vertices recorded by the last query
+///\param s index of the start vertex
+///\param t index of the target vertex
+///@return contents of the vertices in the path, in order, or an empty vector if t wasn't reached
+template <class T>
+std::vector<T> QueryWorkspace<T>::getPath(int s, int t) const {
+    std::vector<T> res;
+    if (s != t && pred[t] == -1) return res;
+    for (int v = t; v != s; v = pred[v]) res.push_back(graph.getInfo(v));
+    res.push_back(graph.getInfo(s));
+    std::reverse(res.begin(), res.end());
+    return res;
+}
+
+#endif /* QUERYWORKSPACE_H_ */
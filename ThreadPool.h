@@ -0,0 +1,106 @@
+///\file
+/// Fixed-size pool of worker threads shared by the parallel algorithms
+
+#ifndef THREADPOOL_H_
+#define THREADPOOL_H_
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+/************************* ThreadPool  **************************/
+
+class ThreadPool {
+    std::vector<std::thread> workers;
+    std::queue<std::function<void()>> tasks;
+    std::mutex mutex;
+    std::condition_variable available;
+    bool stopping = false;
+
+    void work();
+
+public:
+    explicit ThreadPool(int threads = defaultThreads());
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+    ~ThreadPool();
+
+    static int defaultThreads();
+    int size() const;
+    template <class F> auto submit(F task) -> std::future<decltype(task())>;
+    template <class F> void runOnAll(F task);
+};
+
+///@return the number of hardware threads, at least 1
+inline int ThreadPool::defaultThreads() {
+    int threads = std::thread::hardware_concurrency();
+    return threads > 0 ? threads : 1;
+}
+
+///Starts the workers
+///\param threads number of worker threads, at least 1
+inline ThreadPool::ThreadPool(int threads) {
+    if (threads < 1) threads = 1;
+    workers.reserve(threads);
+    for (int i = 0; i < threads; i++) workers.emplace_back([this] { work(); });
+}
+
+///Finishes the queued tasks and joins the workers
+inline ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    available.notify_all();
+    for (std::thread &worker : workers) worker.join();
+}
+
+inline int ThreadPool::size() const {
+    return workers.size();
+}
+
+inline void ThreadPool::work() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            available.wait(lock, [this] { return stopping || !tasks.empty(); });
+            if (tasks.empty()) return;
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+        task();
+    }
+}
+
+///Queues a task
+///\param task callable with no arguments
+///@return a future for the task's result
+template <class F>
+auto ThreadPool::submit(F task) -> std::future<decltype(task())> {
+    auto packaged = std::make_shared<std::packaged_task<decltype(task())()>>(std::move(task));
+    auto result = packaged->get_future();
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        tasks.emplace([packaged] { (*packaged)(); });
+    }
+    available.notify_one();
+    return result;
+}
+
+///Runs task(worker) once for every worker index 0..size()-1, concurrently, and waits for all of them
+///\param task callable taking the worker index
+template <class F>
+void ThreadPool::runOnAll(F task) {
+    std::vector<std::future<void>> done;
+    done.reserve(size());
+    for (int worker = 0; worker < size(); worker++) done.push_back(submit([&task, worker] { task(worker); }));
+    for (std::future<void> &f : done) f.get();
+}
+
+#endif /* THREADPOOL_H_ */
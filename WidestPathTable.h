@@ -0,0 +1,137 @@
+///\file
+/// Precomputed widest path (bottleneck) table from a set of sources to every vertex of a CsrGraph
+
+#ifndef WIDESTPATHTABLE_H_
+#define WIDESTPATHTABLE_H_
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <vector>
+#include "CsrGraph.h"
+#include "QueryWorkspace.h"
+#include "ThreadPool.h"
+
+/************************* WidestPathTable  **************************/
+
+///Widths and predecessors of the widest paths from some sources, or from every vertex, to every vertex, so each
+///bottleneck query is a lookup and each path a walk back through the predecessors.
+///A row is the result of a QueryWorkspace widest path from its source, so widths and paths are the ones
+///Graph::firstAlgorithm gives. The rows are built in parallel, one workspace per worker, and take 8 bytes per vertex
+///each: choosing the sources bounds the memory, every vertex as a source costs 8 V^2 bytes.
+template <class T>
+class WidestPathTable {
+    const CsrGraph<T> &graph;
+    std::vector<int> row;       // row of each vertex, -1 if it isn't a source
+    std::vector<int> width;     // [row * n + v]: width of the widest path from the row's source to v, 0 if unreached
+    std::vector<int> pred;      // [row * n + v]: vertex v is reached from on that path, -1 if none
+    long buildMicros = 0;
+
+    void build(const std::vector<int> &sources, int threads);
+
+public:
+    WidestPathTable(const CsrGraph<T> &graph, int threads);
+    WidestPathTable(const CsrGraph<T> &graph, const std::vector<int> &sources, int threads);
+    bool hasSource(int s) const;
+    int getWidth(int s, int t) const;
+    std::vector<T> getPath(int s, int t) const;
+    int getNumSources() const;
+    size_t getBytes() const;
+    long getBuildMicros() const;
+};
+
+///Builds the table of every vertex
+///\param graph graph of the table, which must outlive it and not change
+///\param threads number of threads building rows
+template <class T>
+WidestPathTable<T>::WidestPathTable(const CsrGraph<T> &graph, int threads) : graph(graph) {
+    std::vector<int> sources(graph.getNumVertex());
+    for (int v = 0; v < graph.getNumVertex(); v++) sources[v] = v;
+    build(sources, threads);
+}
+
+///Builds the table of some sources
+///\param graph graph of the table, which must outlive it and not change
+///\param sources indices of the sources; repeated ones get a single row
+///\param threads number of threads building rows
+template <class T>
+WidestPathTable<T>::WidestPathTable(const CsrGraph<T> &graph, const std::vector<int> &sources, int threads)
+        : graph(graph) {
+    build(sources, threads);
+}
+
+template <class T>
+void WidestPathTable<T>::build(const std::vector<int> &sources, int threads) {
+    auto start = std::chrono::steady_clock::now();
+    size_t n = graph.getNumVertex();
+    row.assign(n, -1);
+    std::vector<int> rows;
+    for (int s : sources) {
+        if (row[s] != -1) continue;
+        row[s] = rows.size();
+        rows.push_back(s);
+    }
+    width.resize(rows.size() * n);
+    pred.resize(rows.size() * n);
+    std::atomic<size_t> next{0};
+    ThreadPool pool(std::max(1, std::min<int>(threads, rows.size())));
+    pool.runOnAll([&](int) {
+        QueryWorkspace<T> workspace(graph);
+        for (size_t r = next++; r < rows.size(); r = next++) {
+            workspace.widestPath(rows[r], rows[r]);
+            int *widths = &width[r * n], *preds = &pred[r * n];
+            for (size_t v = 0; v < n; v++) {
+                widths[v] = workspace.getCap(v);
+                preds[v] = workspace.getPred(v);
+            }
+        }
+    });
+    buildMicros = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start)
+            .count();
+}
+
+///@return whether s, an index, has a row
+template <class T>
+bool WidestPathTable<T>::hasSource(int s) const {
+    return row[s] != -1;
+}
+
+///\param s index of a source
+///\param t index of the target vertex
+///@return the width of the widest path from s to t, 0 if t can't be reached
+template <class T>
+int WidestPathTable<T>::getWidth(int s, int t) const {
+    return width[(size_t) row[s] * graph.getNumVertex() + t];
+}
+
+///\param s index of a source
+///\param t index of the target vertex
+///@return contents of the vertices in the widest path from s to t, in order, or an empty vector if t can't be reached
+template <class T>
+std::vector<T> WidestPathTable<T>::getPath(int s, int t) const {
+    std::vector<T> res;
+    const int *preds = &pred[(size_t) row[s] * graph.getNumVertex()];
+    if (s != t && preds[t] == -1) return res;
+    for (int v = t; v != s; v = preds[v]) res.push_back(graph.getInfo(v));
+    res.push_back(graph.getInfo(s));
+    std::reverse(res.begin(), res.end());
+    return res;
+}
+
+template <class T>
+int WidestPathTable<T>::getNumSources() const {
+    return width.size() / std::max(1, graph.getNumVertex());
+}
+
+///@return memory taken by the widths and predecessors
+template <class T>
+size_t WidestPathTable<T>::getBytes() const {
+    return (width.size() + pred.size()) * sizeof(int) + row.size() * sizeof(int);
+}
+
+template <class T>
+long WidestPathTable<T>::getBuildMicros() const {
+    return buildMicros;
+}
+
+#endif /* WIDESTPATHTABLE_H_ */
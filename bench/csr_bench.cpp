@@ -0,0 +1,78 @@
+// Times the widest path and shortest path queries on the pointer Graph against the same queries on its CsrGraph,
+// run through a QueryWorkspace, on the two large datasets
+// Usage: csr_bench [dataset directory] [queries per dataset], from a Release build (-DCMAKE_BUILD_TYPE=Release)
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "CsrGraph.h"
+#include "Graph.h"
+#include "GraphLoader.h"
+#include "QueryWorkspace.h"
+
+using namespace std;
+
+template <class F>
+static double millis(F run) {
+    auto start = chrono::steady_clock::now();
+    run();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[]) {
+    string dir = argc > 1 ? argv[1] : "Tests";
+    int queries = argc > 2 ? atoi(argv[2]) : 200;
+    printf("%-6s %-14s %12s %12s %8s\n", "data", "query", "Graph ms", "CSR ms", "speedup");
+    for (const char *name : {"in09", "in10"}) {
+        Graph<int> graph;
+        LoadReport report;
+        if (!loadEdgeList(dir + "/" + name + ".txt", graph, report)) {
+            printf("%s: %s\n", name, report.error.c_str());
+            return 1;
+        }
+        int n = graph.getNumVertex();
+        vector<pair<int, int>> pairs;
+        unsigned seed = 1;
+        for (int i = 0; i < queries; i++) {
+            seed = seed * 1103515245 + 12345;
+            int s = 1 + (seed >> 8) % n;
+            seed = seed * 1103515245 + 12345;
+            pairs.emplace_back(s, 1 + (seed >> 8) % n);
+        }
+
+        CsrGraph<int> csr;
+        double freeze = millis([&] { csr = CsrGraph<int>(graph); });
+        QueryWorkspace<int> workspace(csr);
+        long long graphSum = 0, csrSum = 0;
+
+        double graphWidest = millis([&] {
+            for (const pair<int, int> &q : pairs) graphSum += graph.firstAlgorithm(q.first, q.second);
+        });
+        double csrWidest = millis([&] {
+            for (const pair<int, int> &q : pairs)
+                csrSum += workspace.widestPath(csr.findVertexIdx(q.first), csr.findVertexIdx(q.second));
+        });
+        double graphShortest = millis([&] {
+            for (const pair<int, int> &q : pairs) {
+                graph.dijkstraShortestPath(q.first);
+                graphSum += graph.findVertex(q.second)->getDist();
+            }
+        });
+        double csrShortest = millis([&] {
+            for (const pair<int, int> &q : pairs)
+                csrSum += workspace.shortestPath(csr.findVertexIdx(q.first), csr.findVertexIdx(q.second));
+        });
+
+        printf("%-6s %-14s %12s %12.2f\n", name, "freeze", "", freeze);
+        printf("%-6s %-14s %12.2f %12.2f %7.2fx\n", name, "widest path", graphWidest, csrWidest, graphWidest / csrWidest);
+        printf("%-6s %-14s %12.2f %12.2f %7.2fx\n", name, "shortest path", graphShortest, csrShortest,
+               graphShortest / csrShortest);
+        if (graphSum != csrSum) {
+            printf("%s: the CSR queries gave different answers\n", name);
+            return 1;
+        }
+    }
+    return 0;
+}
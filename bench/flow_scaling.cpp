@@ -0,0 +1,67 @@
+// Times the maximum flow engines from the first to the last vertex of the two large datasets, the parallel
+// push-relabel with 1, 2, 4... threads up to the hardware's, against Edmonds-Karp, Dinic and the sequential one
+// Usage: flow_scaling [dataset directory] [repetitions], from a Release build (-DCMAKE_BUILD_TYPE=Release)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+#include "Graph.h"
+#include "GraphLoader.h"
+#include "ThreadPool.h"
+
+using namespace std;
+
+///@return the fastest of repetitions runs in milliseconds, and in value the flow the last one found
+static double bestMillis(int repetitions, const function<int()> &run, int &value) {
+    double best = 0;
+    for (int i = 0; i < repetitions; i++) {
+        auto start = chrono::steady_clock::now();
+        value = run();
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        if (i == 0 || ms < best) best = ms;
+    }
+    return best;
+}
+
+///@return the thread count after threads: twice as many, but ending on maxThreads
+static int nextThreads(int threads, int maxThreads) {
+    return threads < maxThreads && threads * 2 > maxThreads ? maxThreads : threads * 2;
+}
+
+int main(int argc, char *argv[]) {
+    string dir = argc > 1 ? argv[1] : "Tests";
+    int repetitions = argc > 2 ? max(1, atoi(argv[2])) : 5;
+    int maxThreads = ThreadPool::defaultThreads();
+    printf("%-6s %-28s %10s %8s %8s\n", "data", "engine", "ms", "flow", "speedup");
+    for (const char *name : {"in09", "in10"}) {
+        Graph<int> graph;
+        LoadReport report;
+        if (!loadEdgeList(dir + "/" + name + ".txt", graph, report)) {
+            printf("%s: %s\n", name, report.error.c_str());
+            return 1;
+        }
+        int s = 1, t = graph.getNumVertex(), expected = 0, value = 0;
+        double ek = bestMillis(repetitions, [&] { return graph.edmondKarpFlux(s, t); }, expected);
+        printf("%-6s %-28s %10.2f %8d\n", name, "Edmonds-Karp", ek, expected);
+        double dinic = bestMillis(repetitions, [&] { return graph.dinicFlux(s, t); }, value);
+        printf("%-6s %-28s %10.2f %8d\n", name, "Dinic", dinic, value);
+        bool same = value == expected;
+        double sequential = bestMillis(repetitions, [&] { return graph.pushRelabelFlux(s, t); }, value);
+        printf("%-6s %-28s %10.2f %8d %7.2fx\n", name, "push-relabel", sequential, value, 1.0);
+        same = same && value == expected;
+        for (int threads = 1; threads <= maxThreads; threads = nextThreads(threads, maxThreads)) {
+            double ms = bestMillis(repetitions, [&] { return graph.parallelPushRelabelFlux(s, t, threads); }, value);
+            string engine = "parallel, " + to_string(threads) + (threads == 1 ? " thread" : " threads");
+            printf("%-6s %-28s %10.2f %8d %7.2fx\n", name, engine.c_str(), ms, value, sequential / ms);
+            same = same && value == expected;
+        }
+        if (!same) {
+            printf("%s: the engines found different flows\n", name);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,76 @@
+// Times the blocked Floyd-Warshall of FloydWarshall, on 1 thread and on all of the hardware's, against the plain
+// triple loop on one matrix, on the largest datasets the triple loop gets through in seconds. The triple loop only
+// keeps distances, the blocked one predecessors too
+// Usage: floyd_bench [dataset directory], from a Release build (-DCMAKE_BUILD_TYPE=Release)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "FloydWarshall.h"
+#include "Graph.h"
+#include "GraphLoader.h"
+#include "ThreadPool.h"
+
+using namespace std;
+
+template <class F>
+static double millis(F run) {
+    auto start = chrono::steady_clock::now();
+    run();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[]) {
+    string dir = argc > 1 ? argv[1] : "Tests";
+    int threads = ThreadPool::defaultThreads();
+    printf("%-6s %-22s %10s %8s\n", "data", "algorithm", "ms", "speedup");
+    for (const char *name : {"in05", "in06"}) {
+        Graph<int> graph;
+        LoadReport report;
+        if (!loadEdgeList(dir + "/" + name + ".txt", graph, report)) {
+            printf("%s: %s\n", name, report.error.c_str());
+            return 1;
+        }
+        const vector<Vertex<int> *> &vertices = graph.getVertexSet();
+        int n = vertices.size();
+
+        vector<int> dist((size_t) n * n, FloydWarshall::INFTY);
+        double naive = millis([&] {
+            for (int i = 0; i < n; i++) {
+                dist[(size_t) i * n + i] = 0;
+                for (const Edge<int> &edge : vertices[i]->getAdj()) {
+                    int &d = dist[(size_t) i * n + edge.getDest()->getInfo() - 1];
+                    d = min(d, edge.getDuration());
+                }
+            }
+            for (int k = 0; k < n; k++) {
+                for (int i = 0; i < n; i++) {
+                    int *row = &dist[(size_t) i * n];
+                    if (row[k] == FloydWarshall::INFTY) continue;
+                    for (int j = 0; j < n; j++) row[j] = min(row[j], row[k] + dist[(size_t) k * n + j]);
+                }
+            }
+        });
+        printf("%-6s %-22s %10.2f\n", name, "triple loop", naive);
+
+        vector<int> threadCounts = {1};
+        if (threads > 1) threadCounts.push_back(threads);
+        for (int t : threadCounts) {
+            double blocked = millis([&] { graph.floydWarshallShortestPath(t); });
+            string label = "blocked, " + to_string(t) + (t == 1 ? " thread" : " threads");
+            printf("%-6s %-22s %10.2f %7.2fx\n", name, label.c_str(), blocked, naive / blocked);
+            for (int i = 0; i < n; i++) {
+                for (int j = 0; j < n; j++) {
+                    int expected = dist[(size_t) i * n + j] == FloydWarshall::INFTY ? INF : dist[(size_t) i * n + j];
+                    if (graph.getfloydWarshallDist(i + 1, j + 1) != expected) {
+                        printf("%s: the blocked algorithm gave different distances\n", name);
+                        return 1;
+                    }
+                }
+            }
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,112 @@
+// Times DaryHeap with 2, 4 and 8 children per node on the operations the queries make: Dijkstra's shortest
+// duration (int priorities) and the widest path ((-width, order) priorities), from random vertices of the two
+// large datasets
+// Usage: heap_bench [dataset directory] [queries per dataset], from a Release build (-DCMAKE_BUILD_TYPE=Release)
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+#include "CsrGraph.h"
+#include "DaryHeap.h"
+#include "Graph.h"
+#include "GraphLoader.h"
+
+using namespace std;
+
+///Dijkstra's algorithm from s with decrease-key, as HeapQueue runs it
+///@return the sum of the distances of the vertices reached, to compare the arities
+template <int D>
+static long long shortestFrom(const CsrGraph<int> &graph, int s, DaryHeap<int, D> &heap, vector<int> &dist) {
+    fill(dist.begin(), dist.end(), CsrGraph<int>::INFTY);
+    heap.reset(graph.getNumVertex());
+    dist[s] = 0;
+    heap.insert(s, 0);
+    long long sum = 0;
+    while (heap.getSize() > 0) {
+        int v = heap.removeMin();
+        sum += dist[v];
+        for (int e = graph.edgesBegin(v); e < graph.edgesEnd(v); e++) {
+            int w = graph.getDest(e), d = dist[v] + graph.getDuration(e);
+            if (d >= dist[w]) continue;
+            dist[w] = d;
+            if (heap.hasKey(w)) heap.decreaseKey(w, d);
+            else heap.insert(w, d);
+        }
+    }
+    return sum;
+}
+
+///Widest path from s with the heap of QueryWorkspace::widestPath
+///@return the sum of the widths of the vertices reached, to compare the arities
+template <int D>
+static long long widestFrom(const CsrGraph<int> &graph, int s, DaryHeap<pair<int, int>, D> &heap, vector<int> &cap) {
+    fill(cap.begin(), cap.end(), 0);
+    heap.reset(graph.getNumVertex());
+    int widened = 0;
+    cap[s] = CsrGraph<int>::INFTY;
+    heap.insert(s, {-cap[s], widened++});
+    long long sum = 0;
+    while (heap.getSize() > 0) {
+        int v = heap.removeMin();
+        if (v != s) sum += cap[v];
+        for (int e = graph.edgesBegin(v); e < graph.edgesEnd(v); e++) {
+            int w = graph.getDest(e), through = min(cap[v], graph.getCapacity(e));
+            if (through <= cap[w]) continue;
+            cap[w] = through;
+            if (heap.hasKey(w)) heap.decreaseKey(w, {-through, widened++});
+            else heap.insert(w, {-through, widened++});
+        }
+    }
+    return sum;
+}
+
+///Runs both queries from every start with a D-ary heap, printing their times
+///@return the sum of everything the queries computed
+template <int D>
+static long long run(const char *name, const CsrGraph<int> &graph, const vector<int> &starts) {
+    DaryHeap<int, D> heap;
+    DaryHeap<pair<int, int>, D> widthHeap;
+    vector<int> scratch(graph.getNumVertex());
+    long long sum = 0;
+    auto start = chrono::steady_clock::now();
+    for (int s : starts) sum += shortestFrom(graph, s, heap, scratch);
+    auto middle = chrono::steady_clock::now();
+    for (int s : starts) sum += widestFrom(graph, s, widthHeap, scratch);
+    auto end = chrono::steady_clock::now();
+    printf("%-6s %3d %14.2f %14.2f\n", name, D, chrono::duration<double, milli>(middle - start).count(),
+           chrono::duration<double, milli>(end - middle).count());
+    return sum;
+}
+
+int main(int argc, char *argv[]) {
+    string dir = argc > 1 ? argv[1] : "Tests";
+    int queries = argc > 2 ? atoi(argv[2]) : 200;
+    printf("%-6s %3s %14s %14s\n", "data", "D", "shortest ms", "widest ms");
+    for (const char *name : {"in09", "in10"}) {
+        Graph<int> loaded;
+        LoadReport report;
+        if (!loadEdgeList(dir + "/" + name + ".txt", loaded, report)) {
+            printf("%s: %s\n", name, report.error.c_str());
+            return 1;
+        }
+        CsrGraph<int> graph(loaded);
+        vector<int> starts;
+        unsigned seed = 1;
+        for (int i = 0; i < queries; i++) {
+            seed = seed * 1103515245 + 12345;
+            starts.push_back((seed >> 8) % graph.getNumVertex());
+        }
+        long long binary = run<2>(name, graph, starts);
+        long long quaternary = run<4>(name, graph, starts);
+        long long octonary = run<8>(name, graph, starts);
+        if (binary != quaternary || binary != octonary) {
+            printf("%s: the arities gave different answers\n", name);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,68 @@
+// Times QueryWorkspace::widestPath with its bucket queue against its heap, on the two large datasets, and checks
+// that both give the same widths and the same paths
+// Usage: widest_bench [dataset directory] [queries per dataset], from a Release build (-DCMAKE_BUILD_TYPE=Release)
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+#include "CsrGraph.h"
+#include "Graph.h"
+#include "GraphLoader.h"
+#include "QueryWorkspace.h"
+
+using namespace std;
+
+template <class F>
+static double millis(F run) {
+    auto start = chrono::steady_clock::now();
+    run();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[]) {
+    string dir = argc > 1 ? argv[1] : "Tests";
+    int queries = argc > 2 ? atoi(argv[2]) : 200;
+    printf("%-6s %12s %12s %8s\n", "data", "buckets ms", "heap ms", "speedup");
+    for (const char *name : {"in09", "in10"}) {
+        Graph<int> loaded;
+        LoadReport report;
+        if (!loadEdgeList(dir + "/" + name + ".txt", loaded, report)) {
+            printf("%s: %s\n", name, report.error.c_str());
+            return 1;
+        }
+        CsrGraph<int> graph(loaded);
+        int n = graph.getNumVertex();
+        vector<pair<int, int>> pairs;
+        unsigned seed = 1;
+        for (int i = 0; i < queries; i++) {
+            seed = seed * 1103515245 + 12345;
+            int s = (seed >> 8) % n;
+            seed = seed * 1103515245 + 12345;
+            pairs.emplace_back(s, (seed >> 8) % n);
+        }
+
+        QueryWorkspace<int> buckets(graph), heap(graph);
+        long long bucketSum = 0, heapSum = 0;
+        double bucketTime = millis([&] {
+            for (const pair<int, int> &q : pairs) bucketSum += buckets.widestPath(q.first, q.second, true);
+        });
+        double heapTime = millis([&] {
+            for (const pair<int, int> &q : pairs) heapSum += heap.widestPath(q.first, q.second, false);
+        });
+        printf("%-6s %12.2f %12.2f %7.2fx\n", name, bucketTime, heapTime, heapTime / bucketTime);
+
+        for (const pair<int, int> &q : pairs) {
+            int s = q.first, t = q.second;
+            if (buckets.widestPath(s, t, true) != heap.widestPath(s, t, false)
+                || buckets.getPath(s, t) != heap.getPath(s, t)) {
+                printf("%s: the queues gave different answers from %d to %d\n", name, graph.getInfo(s),
+                       graph.getInfo(t));
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
@@ -4,11 +4,49 @@
 #include <string>
 #include <chrono>
 #include "Menu.h"
+#include "GraphLoader.h"
+#include "GraphSnapshot.h"
+#include "BatchRunner.h"
 
 using namespace std;
 bool loadFile(string fileName, Graph<int> &graph); //loads stops and vehicles (nodes and edges) from file to the graph
+bool loadGraph(const string &path, Graph<int> &graph); //loads a text dataset or a binary snapshot, whichever path is
+
+int main(int argc, char *argv[]) {
+    //proj2 --snapshot <dataset> <output> saves a dataset as a binary snapshot for faster loading
+    if(argc == 4 && string(argv[1]) == "--snapshot"){
+        Graph<int> graph;
+        string error;
+        if(!loadGraph(argv[2], graph)) return 1;
+        if(!writeSnapshot(graph, argv[3], error)){
+            cout << error << endl;
+            return 1;
+        }
+        cout << "Snapshot written to " << argv[3] << endl;
+        return 0;
+    }
+
+    //proj2 --batch <dataset> <queries> <output> [threads] answers every query of a file, see BatchRunner.h
+    if((argc == 5 || argc == 6) && string(argv[1]) == "--batch"){
+        Graph<int> graph;
+        BatchReport report;
+        int threads = argc == 6 ? atoi(argv[5]) : 0;
+        if(!loadGraph(argv[2], graph)) return 1;
+        auto start = chrono::steady_clock::now();
+        if(!runBatch(graph, argv[3], argv[4], threads > 0 ? threads : ThreadPool::defaultThreads(), report)){
+            cout << report.error << endl;
+            return 1;
+        }
+        if(report.tableSources > 0){
+            cout << "Widest path table of " << report.tableSources << " sources, " << report.tableBytes / 1024
+                 << "KiB, built in " << report.tableMicros << "us\n";
+        }
+        cout << report.queries << " queries answered in "
+             << chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count()
+             << "ms, results written to " << argv[4] << endl;
+        return 0;
+    }
 
-int main() {
     Menu menu;
     string fileName;
     cout << "Insert Dataset File name:\n";
@@ -46,22 +84,28 @@ int main() {
 }
 
 bool loadFile(string fileName, Graph<int> &graph){
-    ifstream stream;
-    stream.open("../Tests/" + fileName, ifstream::in);
-    int nNodes, nEdges, origin, dest, cap, dur;
-    //get nodes and edges
-    stream >> nNodes >> nEdges;
-    graph.setNumberNodes(nNodes);
-    graph.setNumberEdges(nEdges);
+    return loadGraph("../Tests/" + fileName, graph);
+}
 
-    //create nodes and add them to the graph
-    for(int i = 1; i <= nNodes; i++){
-        if(!graph.addVertex(i)) return false;
+bool loadGraph(const string &path, Graph<int> &graph){
+    if(isSnapshotFile(path)){
+        GraphSnapshot snapshot;
+        string error;
+        auto start = chrono::steady_clock::now();
+        if(!snapshot.open(path, error) || !snapshot.toGraph(graph)){
+            cout << (error.empty() ? "snapshot nodes clash with the graph" : error) << endl;
+            return false;
+        }
+        cout << snapshot.getNumVertex() << " nodes and " << snapshot.getNumEdges() << " edges loaded from snapshot in "
+             << chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start).count() << "us\n";
+        return true;
     }
-    //get edges and add them to the graph
-    while(!stream.eof()){
-        stream >> origin >> dest >> cap >> dur;
-        if(!graph.addEdge(origin, dest, dur, cap, 1)) return false;
+    LoadReport report;
+    if(!loadEdgeList(path, graph, report)){
+        cout << report.error << endl;
+        return false;
     }
+    cout << report.nodes << " nodes and " << report.edges << " edges read in " << report.parseMicros
+         << "us, graph built in " << report.buildMicros << "us\n";
     return true;
 }
@@ -0,0 +1,109 @@
+///\file
+/// Helpers shared by the checks in test/: the datasets of Tests/ and a count of the failed expectations
+
+#ifndef TESTSUPPORT_H_
+#define TESTSUPPORT_H_
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include "GraphLoader.h"
+
+///@return number of expectations that failed so far
+inline int &failures() {
+    static int count = 0;
+    return count;
+}
+
+///Records an expectation, printing what was expected if it doesn't hold
+///\param ok whether the expectation holds
+///\param what what was expected
+inline void expect(bool ok, const std::string &what) {
+    if (ok) return;
+    failures()++;
+    std::cerr << "FAILED: " << what << '\n';
+}
+
+///@return the paths of the datasets in dir, every .txt file but README.txt, sorted by name
+inline std::vector<std::string> datasets(const std::string &dir) {
+    std::vector<std::string> res;
+    for (const std::filesystem::directory_entry &entry : std::filesystem::directory_iterator(dir)) {
+        const std::filesystem::path &path = entry.path();
+        if (path.extension() == ".txt" && path.filename() != "README.txt") res.push_back(path.string());
+    }
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+///@return the dataset directory given as the first argument, Tests/ under the working directory if none is
+inline std::string datasetDir(int argc, char *argv[]) {
+    return argc > 1 ? argv[1] : "Tests";
+}
+
+///Loads a dataset into an empty graph, exiting if it can't be loaded
+inline void loadDataset(const std::string &path, Graph<int> &graph) {
+    LoadReport report;
+    if (!loadEdgeList(path, graph, report)) {
+        std::cerr << path << ": " << report.error << '\n';
+        std::exit(2);
+    }
+}
+
+///@return up to count vertices of 1..n, evenly spread and always including 1 and n
+inline std::vector<int> sampleVertices(int n, int count) {
+    std::vector<int> res;
+    for (int i = 0; i < count; i++) res.push_back(1 + (long long) i * (n - 1) / std::max(1, count - 1));
+    res.erase(std::unique(res.begin(), res.end()), res.end());
+    return res;
+}
+
+///Checks that the flux on the graph's edges is a flow of the given value from s to t, and that the graph's paths
+///decompose it: their amounts add up to the value and, edge by edge, to the flux
+///\param name what is being checked, printed on failure
+///\param s origin of the flow
+///\param t target of the flow
+///\param value value of the flow
+inline void expectFlow(const std::string &name, const Graph<int> &graph, int s, int t, int value) {
+    std::map<int, long long> balance;                    // flow out minus flow in, by vertex
+    std::map<std::pair<int, int>, long long> flux, carried; // by (origin, destination) of the edges
+    for (const Vertex<int> *v : graph.getVertexSet()) {
+        for (const Edge<int> &edge : v->getAdj()) {
+            expect(edge.getFlux() >= 0 && edge.getFlux() <= edge.getCapacity(), name + ": flux within capacity");
+            balance[v->getInfo()] += edge.getFlux();
+            balance[edge.getDest()->getInfo()] -= edge.getFlux();
+            if (edge.getFlux() != 0) flux[{v->getInfo(), edge.getDest()->getInfo()}] += edge.getFlux();
+        }
+    }
+    bool conserved = true;
+    for (const std::pair<const int, long long> &vertex : balance) {
+        long long expected = s == t ? 0 : vertex.first == s ? value : vertex.first == t ? -value : 0;
+        conserved = conserved && vertex.second == expected;
+    }
+    expect(conserved, name + ": flux conserved, with " + std::to_string(value) + " leaving the origin");
+
+    long long total = 0;
+    for (int id = 0; id < graph.paths.size(); id++) {
+        const int *begin = graph.paths.begin(id), *end = graph.paths.end(id);
+        expect(*begin == s && *(end - 1) == t, name + ": a path from the origin to the target");
+        for (const int *v = begin; v + 1 < end; v++) carried[{*v, *(v + 1)}] += graph.paths.getAmount(id);
+        total += graph.paths.getAmount(id);
+    }
+    expect(total == value, name + ": path amounts add up to the flow");
+    expect(carried == flux, name + ": paths carry the flux of every edge");
+}
+
+///Prints the outcome of a check
+///\param check name of the check
+///@return its exit status: 0 if every expectation held
+inline int finish(const std::string &check) {
+    if (failures() == 0) std::cout << check << ": every check passed\n";
+    else std::cout << check << ": " << failures() << " checks failed\n";
+    return failures() == 0 ? 0 : 1;
+}
+
+#endif /* TESTSUPPORT_H_ */
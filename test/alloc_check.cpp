@@ -0,0 +1,66 @@
+// Checks that the traversals reuse their scratch space: once a first query has sized it, Dijkstra's algorithm
+// with every queue policy, the breadth-first search and the CSR queries must not allocate on the largest dataset
+
+#include <cstdlib>
+#include <new>
+#include <string>
+#include "CsrGraph.h"
+#include "DijkstraQueues.h"
+#include "QueryWorkspace.h"
+#include "TestSupport.h"
+
+using namespace std;
+
+static size_t allocations = 0;
+
+void *operator new(size_t size) {
+    allocations++;
+    if (void *p = malloc(size == 0 ? 1 : size)) return p;
+    throw bad_alloc();
+}
+
+void operator delete(void *p) noexcept {
+    free(p);
+}
+
+void operator delete(void *p, size_t) noexcept {
+    free(p);
+}
+
+///Runs query twice from each sampled origin: the first round may size the scratch space, the second must not allocate
+template <class F>
+static void expectNoAllocation(const string &name, const vector<int> &origins, F query) {
+    for (int s : origins) query(s);
+    size_t before = allocations;
+    for (int s : origins) query(s);
+    size_t count = allocations - before;
+    expect(count == 0, name + ": " + to_string(count) + " allocations after warm-up");
+}
+
+int main(int argc, char *argv[]) {
+    string path = datasetDir(argc, argv) + "/in10.txt";
+    Graph<int> graph;
+    loadDataset(path, graph);
+    CsrGraph<int> csr(graph);
+    QueryWorkspace<int> workspace(csr);
+    int n = graph.getNumVertex();
+    vector<int> origins = sampleVertices(n, 8);
+
+    expectNoAllocation(path + ", Dijkstra with the heap", origins, [&](int s) {
+        graph.dijkstraShortestPath<HeapQueue>(s);
+    });
+    expectNoAllocation(path + ", Dijkstra with Dial's buckets", origins, [&](int s) {
+        graph.dijkstraShortestPath<DialQueue>(s);
+    });
+    expectNoAllocation(path + ", Dijkstra with the radix heap", origins, [&](int s) {
+        graph.dijkstraShortestPath<RadixHeapQueue>(s);
+    });
+    expectNoAllocation(path + ", breadth-first search", origins, [&](int s) { graph.unweightedShortestPath(s); });
+    expectNoAllocation(path + ", CSR shortest path", origins, [&](int s) {
+        workspace.shortestPath(csr.findVertexIdx(s), csr.findVertexIdx(n));
+    });
+    expectNoAllocation(path + ", CSR widest path", origins, [&](int s) {
+        workspace.widestPath(csr.findVertexIdx(s), csr.findVertexIdx(n));
+    });
+    return finish("alloc_check");
+}
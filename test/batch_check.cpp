@@ -0,0 +1,117 @@
+// Checks that batch mode answers like the menu: every algorithm is run through runBatch on sampled pairs of every
+// dataset, origin equal to target included, and each CSV line must match the one built from what the Graph
+// methods behind the menu options return
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "BatchRunner.h"
+#include "TestSupport.h"
+
+using namespace std;
+
+///@return a CSV line without its last field, the latency
+static string withoutLatency(const string &line) {
+    return line.substr(0, line.rfind(','));
+}
+
+///@return the answer the menu gives to query, run on graph, in the form of a batch result
+static BatchResult menuAnswer(Graph<int> &graph, const BatchQuery &query) {
+    BatchResult res;
+    res.query = query;
+    res.status = "ok";
+    int s = query.origin, t = query.target;
+    graph.paths.clear();
+    if (query.algorithm == "1.1" || query.algorithm == "sp") {
+        if (query.algorithm == "1.1") res.value = graph.firstAlgorithm(s, t);
+        else {
+            graph.dijkstraShortestPath(s);
+            res.value = graph.findVertex(t)->getDist();
+        }
+        vector<int> path = graph.getPath(s, t);
+        if (path.empty()) {
+            res.status = "no path";
+            res.value = 0;
+        } else res.paths.add(path, res.value);
+        return res;
+    }
+    if (query.algorithm == "1.2") {
+        graph.paretoOptimalGroupSizeAndTransportShift(s, t);
+        res.value = graph.paths.size();
+    } else if (query.algorithm == "2.1") {
+        res.value = graph.FindPathGivenGroupSize(s, t, query.group);
+        if (res.value < query.group) res.status = "partial";
+    } else if (query.algorithm == "2.2") {
+        if (graph.FindPathGivenGroupSize(s, t, query.group) < query.group) res.status = "partial";
+        res.value = graph.increaseGroupSize(s, t, query.increase);
+        if (res.value < 0) res.status = "partial";
+    } else if (query.algorithm == "2.3") {
+        res.value = graph.edmondKarpFlux(s, t);
+    } else {
+        graph.edmondKarpFlux(s, t);
+        if (query.algorithm == "2.4") {
+            res.value = graph.longestPath(s, t);
+            if (res.value == NINF) res.status = "no path";
+        } else {
+            WaitingTimes<int> times = graph.waitingTimes(s, t);
+            res.value = times.biggest;
+            res.waits = times.waits;
+        }
+        graph.paths.clear();
+    }
+    res.paths = graph.paths;
+    return res;
+}
+
+int main(int argc, char *argv[]) {
+    filesystem::path dir = filesystem::temp_directory_path();
+    string queryPath = (dir / "proj2_batch_check.txt").string(), outputPath = (dir / "proj2_batch_check.csv").string();
+    for (const string &dataset : datasets(datasetDir(argc, argv))) {
+        Graph<int> graph;
+        loadDataset(dataset, graph);
+        vector<BatchQuery> queries;
+        vector<int> sample = sampleVertices(graph.getNumVertex(), 3);
+        for (int s : sample) {
+            for (int t : sample) {
+                for (const char *algorithm : {"1.1", "sp", "1.2", "2.1", "2.2", "2.3", "2.4", "2.5"}) {
+                    BatchQuery query;
+                    query.line = queries.size() + 1;
+                    query.algorithm = algorithm;
+                    query.origin = s;
+                    query.target = t;
+                    if (query.algorithm == "2.1" || query.algorithm == "2.2") query.group = 5;
+                    if (query.algorithm == "2.2") query.increase = 3;
+                    queries.push_back(query);
+                }
+            }
+        }
+        ofstream file(queryPath);
+        for (const BatchQuery &query : queries) {
+            file << query.algorithm << ' ' << query.origin << ' ' << query.target;
+            if (query.group > 0) file << ' ' << query.group;
+            if (query.increase > 0) file << ' ' << query.increase;
+            file << '\n';
+        }
+        file.close();
+
+        BatchReport report;
+        if (!runBatch(graph, queryPath, outputPath, 2, report)) {
+            expect(false, dataset + ": " + report.error);
+            continue;
+        }
+        ifstream output(outputPath);
+        string line;
+        getline(output, line);
+        for (const BatchQuery &query : queries) {
+            ostringstream expected;
+            writeCsv(expected, menuAnswer(graph, query));
+            bool read = (bool) getline(output, line);
+            expect(read && withoutLatency(line) == withoutLatency(expected.str()),
+                   dataset + ": \"" + withoutLatency(line) + "\" instead of \"" + withoutLatency(expected.str()) + "\"");
+        }
+    }
+    remove(queryPath.c_str());
+    remove(outputPath.c_str());
+    return finish("batch_check");
+}
@@ -0,0 +1,81 @@
+// Checks the critical path analysis against longestPath after a maximum flow, from sampled pairs of every dataset:
+// the earliest time of an event is the longest duration to it from the origin, its latest the target's earliest
+// minus the longest duration from it to the target, the floats follow from both and the critical edges lead from
+// the origin to the target. Also checks that a new edge reaches the cached topological order both rely on
+
+#include <string>
+#include <vector>
+#include "TestSupport.h"
+
+using namespace std;
+
+static void checkPair(const string &query, Graph<int> &graph, int s, int t) {
+    graph.edmondKarpFlux(s, t);
+    int longest = graph.longestPath(s, t);
+    CriticalPath<int> cpm = graph.criticalPath(s, t);
+    expect(cpm.duration == (longest == NINF ? 0 : longest), query + ": duration is the longest path's");
+    if (longest == NINF) return;
+
+    const vector<Vertex<int> *> &vertices = graph.getVertexSet();
+    vector<int> fromOrigin;
+    for (const Vertex<int> *v : vertices) fromOrigin.push_back(v->getDist());
+    int wrongEarliest = 0, wrongLatest = 0, wrongFloats = 0;
+    for (size_t i = 0; i < vertices.size(); i++) {
+        const CpmNode<int> &node = cpm.nodes[i];
+        if (!node.onNetwork) continue;
+        wrongEarliest += node.earliest != fromOrigin[i];
+        wrongLatest += node.latest != cpm.duration - graph.longestPath(node.info, t);
+        wrongFloats += node.totalFloat != node.latest - node.earliest || node.freeFloat < 0
+                       || node.freeFloat > node.totalFloat;
+    }
+    expect(wrongEarliest == 0, query + ": " + to_string(wrongEarliest) + " earliest times differ from longestPath");
+    expect(wrongLatest == 0, query + ": " + to_string(wrongLatest) + " latest times differ from longestPath");
+    expect(wrongFloats == 0, query + ": " + to_string(wrongFloats) + " events with inconsistent floats");
+
+    // the critical edges are tight, and following them from the origin reaches the target
+    vector<int> position(vertices.size() + 1);
+    for (size_t i = 0; i < vertices.size(); i++) position[cpm.nodes[i].info] = i;
+    vector<char> reached(vertices.size() + 1, 0);
+    reached[s] = 1;
+    bool tight = true;
+    for (int pass = 0; pass < (int) vertices.size(); pass++) {
+        for (int e : cpm.criticalEdges) {
+            const CpmEdge<int> &edge = cpm.edges[e];
+            tight = tight && edge.totalFloat == 0 && edge.freeFloat == 0 && edge.earliestStart == edge.latestStart
+                    && edge.earliestFinish == cpm.nodes[position[edge.to]].earliest;
+            if (reached[edge.from]) reached[edge.to] = 1;
+        }
+        if (reached[t]) break;
+    }
+    expect(tight, query + ": a critical edge has float");
+    expect(reached[t], query + ": the critical edges don't lead to the target");
+}
+
+///A longer route added after the order was cached must be the one longestPath and criticalPath take
+static void checkNewEdge() {
+    Graph<int> graph;
+    for (int v = 1; v <= 4; v++) graph.addVertex(v);
+    graph.addEdge(1, 2, 1, 5, 1);
+    graph.addEdge(2, 4, 1, 5, 1);
+    graph.addEdge(1, 3, 1, 5, 1);
+    graph.edmondKarpFlux(1, 4);
+    expect(graph.longestPath(1, 4) == 2 && graph.criticalPath(1, 4).duration == 2, "before the new edge");
+    graph.addEdge(3, 4, 7, 5, 1);
+    graph.edmondKarpFlux(1, 4);
+    expect(graph.longestPath(1, 4) == 8 && graph.criticalPath(1, 4).duration == 8, "after the new edge");
+}
+
+int main(int argc, char *argv[]) {
+    for (const string &path : datasets(datasetDir(argc, argv))) {
+        Graph<int> graph;
+        loadDataset(path, graph);
+        vector<int> sample = sampleVertices(graph.getNumVertex(), 4);
+        for (int s : sample) {
+            for (int t : sample) {
+                if (s != t) checkPair(path + ": " + to_string(s) + " -> " + to_string(t), graph, s, t);
+            }
+        }
+    }
+    checkNewEdge();
+    return finish("critical_path_check");
+}
@@ -0,0 +1,125 @@
+// Checks that a CsrGraph is an exact copy of the Graph it's frozen from, that flux goes back and forth between
+// them unchanged, and that the queries run on it, its own and QueryWorkspace's, answer like the ones on the Graph
+
+#include <string>
+#include <vector>
+#include "CsrGraph.h"
+#include "Graph.h"
+#include "QueryWorkspace.h"
+#include "TestSupport.h"
+
+using namespace std;
+
+static void checkStructure(const string &name, const Graph<int> &graph, const CsrGraph<int> &csr) {
+    expect(csr.getNumVertex() == graph.getNumVertex(), name + ": vertex count");
+    int edges = 0;
+    for (int v = 0; v < csr.getNumVertex(); v++) {
+        const Vertex<int> *vertex = graph.getVertexSet()[v];
+        expect(csr.getInfo(v) == vertex->getInfo() && csr.findVertexIdx(vertex->getInfo()) == v,
+               name + ": vertex " + to_string(vertex->getInfo()));
+        expect(csr.edgesEnd(v) - csr.edgesBegin(v) == (int) vertex->getAdj().size(),
+               name + ": out-degree of " + to_string(vertex->getInfo()));
+        int e = csr.edgesBegin(v);
+        for (const Edge<int> &edge : vertex->getAdj()) {
+            if (e == csr.edgesEnd(v)) break;
+            expect(csr.getInfo(csr.getDest(e)) == edge.getDest()->getInfo() && csr.getCapacity(e) == edge.getCapacity()
+                   && csr.getDuration(e) == edge.getDuration(),
+                   name + ": edge " + to_string(e));
+            e++;
+        }
+        edges += vertex->getAdj().size();
+    }
+    expect(csr.getNumEdges() == edges, name + ": edge count");
+}
+
+static vector<int> fluxOf(const Graph<int> &graph) {
+    vector<int> res;
+    for (const Vertex<int> *v : graph.getVertexSet())
+        for (const Edge<int> &edge : v->getAdj()) res.push_back(edge.getFlux());
+    return res;
+}
+
+static void checkFluxRoundTrip(const string &name, Graph<int> &graph) {
+    int n = graph.getNumVertex();
+    graph.edmondKarpFlux(1, n);
+    vector<int> flux = fluxOf(graph);
+    CsrGraph<int> csr(graph);
+    for (int e = 0; e < csr.getNumEdges(); e++) expect(csr.getFlux(e) == flux[e], name + ": copied flux");
+    graph.zeroFlux();
+    csr.writeFlux(graph);
+    expect(fluxOf(graph) == flux, name + ": flux written back");
+    csr.zeroFlux();
+    csr.readFlux(graph);
+    for (int e = 0; e < csr.getNumEdges(); e++) expect(csr.getFlux(e) == flux[e], name + ": flux read again");
+    graph.zeroFlux();
+}
+
+static void checkQueries(const string &name, Graph<int> &graph, CsrGraph<int> &csr) {
+    QueryWorkspace<int> workspace(csr);
+    vector<int> sample = sampleVertices(graph.getNumVertex(), 12);
+    for (int s : sample) {
+        for (int t : sample) {
+            if (s == t) continue;
+            string query = name + ": " + to_string(s) + " -> " + to_string(t);
+            int si = csr.findVertexIdx(s), ti = csr.findVertexIdx(t);
+            int width = graph.firstAlgorithm(s, t);
+            expect(workspace.widestPath(si, ti) == width, query + ", widest path width");
+            expect(workspace.getPath(si, ti) == graph.getPath(s, t), query + ", widest path");
+            expect(csr.widestPath(si, ti) == width, query + ", CSR widest path width");
+            expect(csr.getPath(si, ti) == graph.getPath(s, t), query + ", CSR widest path");
+        }
+        graph.dijkstraShortestPath(s);
+        csr.dijkstraShortestPath(csr.findVertexIdx(s));
+        for (int t : sample) {
+            string query = name + ": " + to_string(s) + " -> " + to_string(t);
+            int si = csr.findVertexIdx(s), ti = csr.findVertexIdx(t);
+            expect(workspace.shortestPath(si, ti) == graph.findVertex(t)->getDist(), query + ", shortest duration");
+            expect(workspace.getPath(si, ti) == graph.getPath(s, t), query + ", shortest path");
+            expect(csr.getDist(ti) == graph.findVertex(t)->getDist() && csr.getPath(si, ti) == graph.getPath(s, t),
+                   query + ", CSR shortest path");
+        }
+        graph.unweightedShortestPath(s);
+        csr.unweightedShortestPath(csr.findVertexIdx(s));
+        for (int t : sample) {
+            string query = name + ": " + to_string(s) + " -> " + to_string(t);
+            int si = csr.findVertexIdx(s), ti = csr.findVertexIdx(t);
+            expect(csr.getDist(ti) == graph.findVertex(t)->getDist() && csr.getPath(si, ti) == graph.getPath(s, t),
+                   query + ", CSR breadth-first search");
+        }
+    }
+}
+
+///The flow queries: Edmonds-Karp must find the Graph's value and a valid flow, and the longest path over the flux
+///(the soonest reunion, 2.4) must match the Graph's on the same flux
+static void checkFlowQueries(const string &name, Graph<int> &graph, CsrGraph<int> &csr) {
+    vector<int> sample = sampleVertices(graph.getNumVertex(), 4);
+    for (int s : sample) {
+        for (int t : sample) {
+            string query = name + ": " + to_string(s) + " -> " + to_string(t);
+            int si = csr.findVertexIdx(s), ti = csr.findVertexIdx(t);
+            int value = graph.edmondKarpFlux(s, t);
+            int reunion = graph.longestPath(s, t);
+            csr.readFlux(graph);
+            expect(csr.longestPath(si, ti) == reunion, query + ", CSR longest path on the Graph's flux");
+            expect(csr.edmondKarpFlux(si, ti) == value, query + ", CSR Edmonds-Karp value");
+            csr.writeFlux(graph);
+            graph.paths = csr.paths;
+            expectFlow(query + ", CSR Edmonds-Karp", graph, s, t, value);
+            expect(csr.longestPath(si, ti) == graph.longestPath(s, t), query + ", CSR longest path on its own flux");
+        }
+    }
+    graph.zeroFlux();
+}
+
+int main(int argc, char *argv[]) {
+    for (const string &path : datasets(datasetDir(argc, argv))) {
+        Graph<int> graph;
+        loadDataset(path, graph);
+        CsrGraph<int> csr(graph);
+        checkStructure(path, graph, csr);
+        checkFluxRoundTrip(path, graph);
+        checkQueries(path, graph, csr);
+        checkFlowQueries(path, graph, csr);
+    }
+    return finish("csr_check");
+}
@@ -0,0 +1,113 @@
+// Checks that the priority queue policies of Graph::dijkstraShortestPath give the same distances and the same
+// paths from sampled origins of every dataset, and that they answer like Dijkstra's algorithm did before them: the
+// same distances, and the same predecessors but where several tie, in which case the one earliest in vertexSet
+
+#include <functional>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "DijkstraQueues.h"
+#include "TestSupport.h"
+
+using namespace std;
+
+struct Tree {
+    vector<int> dist;
+    vector<vector<int>> paths;
+};
+
+///@return the distance and the path from s to every vertex, found with the Queue policy
+template <class Queue>
+static Tree shortestFrom(Graph<int> &graph, int s) {
+    graph.dijkstraShortestPath<Queue>(s);
+    Tree res;
+    for (int t = 1; t <= graph.getNumVertex(); t++) {
+        res.dist.push_back(graph.findVertex(t)->getDist());
+        res.paths.push_back(graph.getPath(s, t));
+    }
+    return res;
+}
+
+///Dijkstra's algorithm as it was before the queue policies, with a binary heap and a strict relaxation: the first
+///predecessor to give a vertex its distance keeps it, whatever its position
+///\param pred receives the position of the predecessor of every vertex in vertexSet, -1 for s and the unreached
+///@return the distance to every vertex, by position in vertexSet
+static vector<int> baselineFrom(const Graph<int> &graph, int s, vector<int> &pred) {
+    const vector<Vertex<int> *> &vertices = graph.getVertexSet();
+    unordered_map<const Vertex<int> *, int> position;
+    for (int i = 0; i < (int) vertices.size(); i++) position[vertices[i]] = i;
+    vector<int> dist(vertices.size(), INF);
+    pred.assign(vertices.size(), -1);
+    priority_queue<pair<int, int>, vector<pair<int, int>>, greater<pair<int, int>>> heap;
+    dist[position[graph.findVertex(s)]] = 0;
+    heap.emplace(0, position[graph.findVertex(s)]);
+    while (!heap.empty()) {
+        auto [d, v] = heap.top();
+        heap.pop();
+        if (d > dist[v]) continue;
+        for (const Edge<int> &edge : vertices[v]->getAdj()) {
+            int w = position[edge.getDest()];
+            if (d + edge.getDuration() >= dist[w]) continue;
+            dist[w] = d + edge.getDuration();
+            pred[w] = v;
+            heap.emplace(dist[w], w);
+        }
+    }
+    return dist;
+}
+
+///Compares the paths dijkstraShortestPath left with the baseline's: a vertex with a single tight predecessor must
+///have the baseline's, and one with several tied over positive durations the earliest of them in vertexSet. Ties
+///over a zero duration keep whichever came first, and aren't checked
+static void checkAgainstBaseline(const string &query, const Graph<int> &graph, const vector<int> &dist,
+                                 const vector<int> &pred) {
+    const vector<Vertex<int> *> &vertices = graph.getVertexSet();
+    unordered_map<const Vertex<int> *, int> position;
+    for (int i = 0; i < (int) vertices.size(); i++) position[vertices[i]] = i;
+    vector<int> tight(vertices.size(), 0), earliest(vertices.size(), -1);
+    vector<bool> overZero(vertices.size(), false);
+    for (int v = 0; v < (int) vertices.size(); v++) {
+        if (dist[v] == INF) continue;
+        for (const Edge<int> &edge : vertices[v]->getAdj()) {
+            int w = position[edge.getDest()];
+            if (pred[w] == -1 || dist[v] + edge.getDuration() != dist[w]) continue;
+            tight[w]++;
+            if (edge.getDuration() == 0) overZero[w] = true;
+            else if (earliest[w] == -1) earliest[w] = v;
+        }
+    }
+    int moved = 0;
+    for (int w = 0; w < (int) vertices.size(); w++) {
+        if (pred[w] == -1 || (tight[w] > 1 && overZero[w])) continue;
+        int now = position[vertices[w]->getPath()];
+        moved += now != (tight[w] == 1 ? pred[w] : earliest[w]);
+    }
+    expect(moved == 0, query + ": " + to_string(moved) + " predecessors differ from the baseline's tie rule");
+}
+
+int main(int argc, char *argv[]) {
+    for (const string &path : datasets(datasetDir(argc, argv))) {
+        Graph<int> graph;
+        loadDataset(path, graph);
+        for (int s : sampleVertices(graph.getNumVertex(), 8)) {
+            string query = path + ": from " + to_string(s);
+            Tree heap = shortestFrom<HeapQueue>(graph, s);
+            Tree dial = shortestFrom<DialQueue>(graph, s);
+            Tree radix = shortestFrom<RadixHeapQueue>(graph, s);
+            expect(dial.dist == heap.dist, query + ", Dial's buckets: distances");
+            expect(dial.paths == heap.paths, query + ", Dial's buckets: paths");
+            expect(radix.dist == heap.dist, query + ", radix heap: distances");
+            expect(radix.paths == heap.paths, query + ", radix heap: paths");
+            vector<int> pred;
+            vector<int> dist = baselineFrom(graph, s, pred);
+            vector<int> byPosition;
+            for (const Vertex<int> *v : graph.getVertexSet()) byPosition.push_back(heap.dist[v->getInfo() - 1]);
+            expect(byPosition == dist, query + ", distances of the baseline");
+            graph.dijkstraShortestPath<HeapQueue>(s);
+            checkAgainstBaseline(query, graph, dist, pred);
+        }
+    }
+    return finish("dijkstra_check");
+}
@@ -0,0 +1,58 @@
+// Checks filterPathsByDominance against the pairwise test it replaced, on random path sets small enough to be
+// full of ties in size and in capacity
+
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+#include "TestSupport.h"
+
+using namespace std;
+
+typedef set<pair<vector<int>, int>> PathSet;
+
+///@return the paths of store with their capacities
+static PathSet entries(const PathStore<int> &store) {
+    PathSet res;
+    for (int id = 0; id < store.size(); id++) res.emplace(store.getPath(id), store.getAmount(id));
+    return res;
+}
+
+///The filter as it was first written: a path is dropped if another one is shorter and at least as wide, or wider
+///and at most as long
+static PathSet pairwiseFilter(const PathStore<int> &store) {
+    PathSet res;
+    for (int id = 0; id < store.size(); id++) {
+        bool dominated = false;
+        for (int other = 0; other < store.size(); other++) {
+            int length = store.getLength(id), otherLength = store.getLength(other);
+            int capacity = store.getAmount(id), otherCapacity = store.getAmount(other);
+            if ((otherLength < length && otherCapacity >= capacity)
+                || (otherCapacity > capacity && otherLength <= length)) dominated = true;
+        }
+        if (!dominated) res.emplace(store.getPath(id), store.getAmount(id));
+    }
+    return res;
+}
+
+int main() {
+    unsigned seed = 1;
+    auto next = [&seed](int bound) {
+        seed = seed * 1103515245 + 12345;
+        return (int) ((seed >> 8) % bound);
+    };
+    Graph<int> graph;
+    for (int round = 0; round < 5000; round++) {
+        graph.paths.clear();
+        int count = next(round % 10 == 0 ? 200 : 12);
+        for (int i = 0; i < count; i++) {
+            vector<int> path(1 + next(6));
+            for (int &node : path) node = 1 + next(3);
+            graph.paths.add(path, 1 + next(5));
+        }
+        PathSet expected = pairwiseFilter(graph.paths);
+        expect(entries(graph.filterPathsByDominance()) == expected,
+               "round " + to_string(round) + ": " + to_string(graph.paths.size()) + " paths");
+    }
+    return finish("dominance_check");
+}
@@ -0,0 +1,143 @@
+// Checks PathEnumerator against a plain recursive enumeration of the simple paths, on random graphs small enough to
+// list them all, with parallel edges and ties in capacity: every limit must keep exactly the paths it allows, on one
+// thread and on several, the front-only pruning must keep every path of the front, with its width, and the result,
+// time and cancel limits must stop a search that would otherwise not end
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+#include "CsrGraph.h"
+#include "PathEnumerator.h"
+#include "TestSupport.h"
+
+using namespace std;
+
+typedef map<vector<int>, int> PathMap;  // path -> width
+
+///Every simple path from v to target over edges wider than minCapacity and with at most maxHops edges
+static void allPaths(const Graph<int> &graph, int v, int target, int width, int minCapacity, int maxHops,
+                     vector<int> &path, PathMap &res) {
+    path.push_back(v);
+    if (v == target) {
+        int &best = res[path];
+        best = max(best, width);
+    } else if ((int) path.size() <= maxHops) {
+        for (const Edge<int> &edge : graph.findVertex(v)->getAdj()) {
+            int w = edge.getDest()->getInfo();
+            if (edge.getCapacity() <= minCapacity || find(path.begin(), path.end(), w) != path.end()) continue;
+            allPaths(graph, w, target, min(width, edge.getCapacity()), minCapacity, maxHops, path, res);
+        }
+    }
+    path.pop_back();
+}
+
+static PathMap reference(const Graph<int> &graph, int s, int t, int minCapacity, int maxHops) {
+    PathMap res;
+    vector<int> path;
+    if (s != t) allPaths(graph, s, t, INF, minCapacity, maxHops, path, res);
+    return res;
+}
+
+static PathMap entries(const PathStore<int> &store) {
+    PathMap res;
+    for (int id = 0; id < store.size(); id++) res[store.getPath(id)] = store.getAmount(id);
+    return res;
+}
+
+///@return the paths of all that no other one beats, being shorter and at least as wide or as short and wider
+static PathMap front(const PathMap &all) {
+    PathMap res;
+    for (const auto &[path, width] : all) {
+        bool dominated = false;
+        for (const auto &[other, otherWidth] : all) {
+            dominated = dominated || (other.size() < path.size() && otherWidth >= width)
+                        || (other.size() <= path.size() && otherWidth > width);
+        }
+        if (!dominated) res[path] = width;
+    }
+    return res;
+}
+
+static void checkRandom(int round, unsigned &seed) {
+    auto next = [&seed](int bound) {
+        seed = seed * 1103515245 + 12345;
+        return (int) ((seed >> 8) % bound);
+    };
+    int n = 4 + next(6);
+    Graph<int> graph;
+    for (int v = 1; v <= n; v++) graph.addVertex(v);
+    for (int e = 3 * n; e > 0; e--) graph.addEdge(1 + next(n), 1 + next(n), 1, 1 + next(4), 1);
+    CsrGraph<int> csr(graph);
+    int s = 1 + next(n), t = 1 + next(n), si = csr.findVertexIdx(s), ti = csr.findVertexIdx(t);
+    string name = "random graph " + to_string(round) + ", " + to_string(s) + " -> " + to_string(t);
+    PathMap all = reference(graph, s, t, 0, n);
+
+    for (int threads : {1, 3}) {
+        PathEnumerator<int> enumerator(csr, threads);
+        string run = name + ", " + to_string(threads) + " threads";
+        EnumerationLimits limits;
+        expect(enumerator.run(si, ti, limits) && entries(enumerator.paths) == all, run + ": every simple path");
+
+        limits.maxHops = 1 + next(3);
+        expect(enumerator.run(si, ti, limits) && entries(enumerator.paths) == reference(graph, s, t, 0, limits.maxHops),
+               run + ": at most " + to_string(limits.maxHops) + " hops");
+        limits.maxHops = -1;
+        limits.minCapacity = 1 + next(3);
+        expect(enumerator.run(si, ti, limits)
+               && entries(enumerator.paths) == reference(graph, s, t, limits.minCapacity, n),
+               run + ": wider than " + to_string(limits.minCapacity));
+        limits.minCapacity = 0;
+
+        limits.frontOnly = true;
+        bool complete = enumerator.run(si, ti, limits);
+        PathMap found = entries(enumerator.paths);
+        bool onFront = true, fromAll = true;
+        for (const auto &[path, width] : front(all)) onFront = onFront && found.count(path) && found[path] == width;
+        // a path found before the front cut its branch may miss a wider parallel edge, the front can't
+        for (const auto &[path, width] : found) fromAll = fromAll && all.count(path) && all[path] >= width;
+        expect(complete && onFront && fromAll, run + ": front only, every path of the front and only simple paths");
+        limits.frontOnly = false;
+
+        if (all.size() > 2) {
+            limits.maxResults = 2;
+            complete = enumerator.run(si, ti, limits);
+            expect(!complete && enumerator.paths.size() <= 2, run + ": stopped after 2 paths");
+            limits.maxResults = 0;
+        }
+    }
+}
+
+///A complete graph has too many simple paths to list; the search has to stop on a limit
+static void checkStops() {
+    int n = 16;
+    Graph<int> graph;
+    for (int v = 1; v <= n; v++) graph.addVertex(v);
+    for (int v = 1; v <= n; v++)
+        for (int w = 1; w <= n; w++)
+            if (v != w) graph.addEdge(v, w, 1, 1 + (v + w) % 5, 1);
+    CsrGraph<int> csr(graph);
+    PathEnumerator<int> enumerator(csr, 2);
+    EnumerationLimits limits;
+    limits.timeLimit = chrono::milliseconds(50);
+    auto start = chrono::steady_clock::now();
+    bool complete = enumerator.run(0, n - 1, limits);
+    auto elapsed = chrono::duration_cast<chrono::milliseconds>(chrono::steady_clock::now() - start).count();
+    expect(!complete && elapsed < 5000, "complete graph: time limit, stopped after " + to_string(elapsed) + " ms");
+
+    atomic<bool> cancel{true};
+    limits.timeLimit = chrono::milliseconds(0);
+    limits.cancel = &cancel;
+    expect(!enumerator.run(0, n - 1, limits), "complete graph: stopped by the cancel flag");
+    limits.cancel = nullptr;
+    expect(enumerator.run(3, 3, limits) && enumerator.paths.empty(), "complete graph: no path from a vertex to itself");
+}
+
+int main() {
+    unsigned seed = 1;
+    for (int round = 0; round < 300; round++) checkRandom(round, seed);
+    checkStops();
+    return finish("enumerator_check");
+}
@@ -0,0 +1,52 @@
+// Cross-checks the maximum flow engines on every dataset: each must find the value Edmonds-Karp finds, leave a
+// valid flow of that value on the edges and decompose it into paths, for a sample of origin/target pairs
+
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+#include "TestSupport.h"
+
+using namespace std;
+
+struct Engine {
+    const char *name;
+    function<int(Graph<int> &, int, int)> run;
+};
+
+static const vector<Engine> engines = {
+    {"Edmonds-Karp", [](Graph<int> &graph, int s, int t) { return graph.edmondKarpFlux(s, t); }},
+    {"Dinic", [](Graph<int> &graph, int s, int t) { return graph.dinicFlux(s, t); }},
+    {"push-relabel", [](Graph<int> &graph, int s, int t) { return graph.pushRelabelFlux(s, t); }},
+    {"parallel push-relabel, 1 thread", [](Graph<int> &graph, int s, int t) {
+         return graph.parallelPushRelabelFlux(s, t, 1);
+     }},
+    {"parallel push-relabel, 4 threads", [](Graph<int> &graph, int s, int t) {
+         return graph.parallelPushRelabelFlux(s, t, 4);
+     }},
+};
+
+int main(int argc, char *argv[]) {
+    for (const string &path : datasets(datasetDir(argc, argv))) {
+        Graph<int> graph;
+        loadDataset(path, graph);
+        vector<int> sample = sampleVertices(graph.getNumVertex(), 5);
+        vector<pair<int, int>> pairs;
+        for (int s : sample)
+            for (int t : sample) pairs.emplace_back(s, t);
+        for (const pair<int, int> &q : pairs) {
+            string query = path + ": " + to_string(q.first) + " -> " + to_string(q.second);
+            int expected = -1;
+            for (const Engine &engine : engines) {
+                graph.paths.clear();
+                int value = engine.run(graph, q.first, q.second);
+                if (expected == -1) expected = value;
+                expect(value == expected, query + ", " + engine.name + " found " + to_string(value) + " instead of "
+                                          + to_string(expected));
+                if (q.first == q.second) expect(value == 0, query + ", " + engine.name + ": flow to itself");
+                expectFlow(query + ", " + engine.name, graph, q.first, q.second, value);
+            }
+        }
+    }
+    return finish("flow_check");
+}
@@ -0,0 +1,126 @@
+// Checks the blocked Floyd-Warshall: on datasets in01 to in06, Graph::floydWarshallShortestPath must find the
+// distances of Dijkstra's algorithm from every vertex, and on random graphs FloydWarshall must find those of the
+// plain triple loop. The random graphs have parallel edges, zero durations, vertices no other reaches and a number
+// of vertices that isn't a multiple of the tile. The paths, from sampled origins on the datasets, must be made of
+// edges and add up to their distance
+
+#include <algorithm>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include "FloydWarshall.h"
+#include "TestSupport.h"
+
+using namespace std;
+
+///@return [i * n + j]: the lightest edge from i to j, INFTY if there's none, and 0 from i to itself
+static vector<int> lightestEdges(int n) {
+    vector<int> res((size_t) n * n, FloydWarshall::INFTY);
+    for (int i = 0; i < n; i++) res[(size_t) i * n + i] = 0;
+    return res;
+}
+
+///@return whether path goes from i to j along edges of lightest and adds up to dist
+static bool validPath(const vector<int> &path, const vector<int> &lightest, int n, int i, int j, int dist) {
+    if (path.empty() || path.front() != i || path.back() != j) return false;
+    long long length = 0;
+    for (size_t k = 0; k + 1 < path.size(); k++) {
+        int edge = lightest[(size_t) path[k] * n + path[k + 1]];
+        if (edge == FloydWarshall::INFTY) return false;
+        length += edge;
+    }
+    return length == dist;
+}
+
+///Compares every distance with Dijkstra's and checks the paths from sampled origins
+static void checkDataset(const string &name, Graph<int> &graph) {
+    const vector<Vertex<int> *> &vertices = graph.getVertexSet();
+    int n = vertices.size();
+    vector<int> lightest = lightestEdges(n);
+    for (int i = 0; i < n; i++) {
+        for (const Edge<int> &edge : vertices[i]->getAdj()) {
+            int &w = lightest[(size_t) i * n + edge.getDest()->getInfo() - 1];
+            w = min(w, edge.getDuration());
+        }
+    }
+    vector<int> dijkstra;
+    for (int s = 1; s <= n; s++) {
+        graph.dijkstraShortestPath(s);
+        for (int t = 1; t <= n; t++) dijkstra.push_back(graph.findVertex(t)->getDist());
+    }
+    vector<int> sample = sampleVertices(n, 20);
+    graph.floydWarshallShortestPath();
+    int wrong = 0, invalid = 0;
+    for (int s = 1; s <= n; s++) {
+        const int *row = &dijkstra[(size_t) (s - 1) * n];
+        for (int t = 1; t <= n; t++) wrong += graph.getfloydWarshallDist(s, t) != row[t - 1];
+    }
+    for (int s : sample) {
+        for (int t = 1; t <= n; t++) {
+            int dist = graph.getfloydWarshallDist(s, t);
+            vector<int> path = graph.getfloydWarshallPath(s, t);
+            for (int &v : path) v--;
+            if (dist == INF) invalid += !path.empty();
+            else invalid += !validPath(path, lightest, n, s - 1, t - 1, dist);
+        }
+    }
+    expect(wrong == 0, name + ": " + to_string(wrong) + " distances differ from Dijkstra's");
+    expect(invalid == 0, name + ": " + to_string(invalid) + " invalid paths");
+}
+
+///A graph of n vertices where the last few have no incoming edges, with parallel edges and zero durations,
+///compared with the triple loop; the rounds run on 1 to 4 threads
+static void checkRandom(int round, int n, unsigned &seed) {
+    auto next = [&seed](int bound) {
+        seed = seed * 1103515245 + 12345;
+        return (int) ((seed >> 8) % bound);
+    };
+    FloydWarshall floyd;
+    floyd.reset(n);
+    vector<int> dist = lightestEdges(n);
+    int sources = max(1, min(n / 3, 10));
+    for (int e = 0; e < 4 * n; e++) {
+        int i = next(n), j = next(n - sources), weight = next(10);
+        for (int copy = 1 + (next(4) == 0); copy > 0; copy--, weight = next(10)) {
+            floyd.addEdge(i, j, weight);
+            dist[(size_t) i * n + j] = min(dist[(size_t) i * n + j], weight);
+        }
+    }
+    vector<int> lightest = dist;
+    floyd.run(1 + round % 4);
+    for (int k = 0; k < n; k++) {
+        for (int i = 0; i < n; i++) {
+            int *row = &dist[(size_t) i * n];
+            if (row[k] == FloydWarshall::INFTY) continue;
+            for (int j = 0; j < n; j++) row[j] = min(row[j], row[k] + dist[(size_t) k * n + j]);
+        }
+    }
+    int wrong = 0, invalid = 0, unreachable = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            int d = dist[(size_t) i * n + j];
+            wrong += floyd.getDist(i, j) != d;
+            unreachable += d == FloydWarshall::INFTY;
+            if (d == FloydWarshall::INFTY) invalid += !floyd.getPath(i, j).empty();
+            else invalid += !validPath(floyd.getPath(i, j), lightest, n, i, j, d);
+        }
+    }
+    string run = "random graph " + to_string(round) + " of " + to_string(n) + " vertices: ";
+    expect(wrong == 0, run + to_string(wrong) + " distances differ from the triple loop's");
+    expect(invalid == 0, run + to_string(invalid) + " invalid paths");
+    expect(unreachable > 0, run + "no unreachable pair");
+}
+
+int main(int argc, char *argv[]) {
+    for (const string &path : datasets(datasetDir(argc, argv))) {
+        string file = filesystem::path(path).filename().string();
+        if (file < "in01" || file >= "in07") continue;
+        Graph<int> graph;
+        loadDataset(path, graph);
+        checkDataset(path, graph);
+    }
+    unsigned seed = 1;
+    for (int n : {7, FloydWarshall::TILE - 1, FloydWarshall::TILE + 1, 2 * FloydWarshall::TILE + 13})
+        for (int round = 0; round < 5; round++) checkRandom(round, n, seed);
+    return finish("floyd_check");
+}
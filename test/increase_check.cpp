@@ -0,0 +1,70 @@
+// Checks that raising a group step by step with increaseGroupSize ends at the maximum flow, on every dataset:
+// each step must leave a valid flow of the size reached so far, decomposed into paths, and the step that can't be
+// met in full must saturate the flow Edmonds-Karp finds in one go. A group whose origin is its target stays on the
+// single-vertex path
+
+#include <string>
+#include <vector>
+#include "TestSupport.h"
+
+using namespace std;
+
+///Raises a group found by FindPathGivenGroupSize in steps of 1, 2, 3... until it can't grow any more
+static void checkIncreases(const string &query, Graph<int> &graph, int s, int t, int maxFlow) {
+    int size = graph.FindPathGivenGroupSize(s, t, 1);
+    expectFlow(query + ", first group", graph, s, t, size);
+    for (int step = 1; size < maxFlow; step++) {
+        int increase = graph.increaseGroupSize(s, t, step);
+        bool fits = size + step <= maxFlow;
+        expect(increase == (fits ? step : -1), query + ", increase by " + to_string(step) + " after " + to_string(size));
+        size = fits ? size + step : maxFlow;
+        expectFlow(query + ", group of " + to_string(size), graph, s, t, size);
+    }
+    expect(graph.increaseGroupSize(s, t, 1) == -1, query + ", increase past the maximum flow");
+    expectFlow(query + ", saturated", graph, s, t, maxFlow);
+}
+
+///A group already at its target keeps the single-vertex path, with no flux, however much it grows
+static void checkStaying(const string &query, Graph<int> &graph, int s) {
+    expect(graph.FindPathGivenGroupSize(s, s, 5) == 5, query + ", group routed to its origin");
+    expect(graph.increaseGroupSize(s, s, 3) == 3, query + ", group grown at its origin");
+    bool noFlux = true;
+    for (const Vertex<int> *v : graph.getVertexSet())
+        for (const Edge<int> &edge : v->getAdj()) noFlux = noFlux && edge.getFlux() == 0;
+    expect(noFlux, query + ", no flux for a group that stays");
+    expect(graph.paths.size() == 1 && graph.paths.getPath(0) == vector<int>{s} && graph.paths.getAmount(0) == 8,
+           query + ", the grown group on the single-vertex path");
+}
+
+///A group that stays at s starts from nothing after a group was routed between other vertices, or after a maximum
+///flow replaced it
+static void checkStayingAfter(const string &query, Graph<int> &graph, int s, int other) {
+    graph.FindPathGivenGroupSize(other, s, 7);
+    expect(graph.increaseGroupSize(s, s, 3) == 3 && graph.paths.size() == 1 && graph.paths.getAmount(0) == 3,
+           query + ", group grown at its origin after one routed from " + to_string(other));
+    graph.FindPathGivenGroupSize(s, s, 5);
+    graph.edmondKarpFlux(other, s);
+    expect(graph.increaseGroupSize(s, s, 3) == 3 && graph.paths.size() == 1 && graph.paths.getAmount(0) == 3,
+           query + ", group grown at its origin after a maximum flow from " + to_string(other));
+}
+
+int main(int argc, char *argv[]) {
+    for (const string &path : datasets(datasetDir(argc, argv))) {
+        Graph<int> graph;
+        loadDataset(path, graph);
+        vector<int> sample = sampleVertices(graph.getNumVertex(), 4);
+        for (int s : sample) {
+            for (int t : sample) {
+                string query = path + ": " + to_string(s) + " -> " + to_string(t);
+                if (s == t) {
+                    checkStaying(query, graph, s);
+                    checkStayingAfter(query, graph, s, s == sample[0] ? sample.back() : sample[0]);
+                    continue;
+                }
+                int maxFlow = graph.edmondKarpFlux(s, t);
+                if (maxFlow > 0) checkIncreases(query, graph, s, t, maxFlow);
+            }
+        }
+    }
+    return finish("increase_check");
+}
@@ -0,0 +1,152 @@
+// Checks the capacity/hop-count Pareto front of paretoOptimalGroupSizeAndTransportShift on sampled pairs of
+// datasets in01 to in06: it must hold one valid path per hop count, match the front of a plain dynamic program over
+// hop counts, and never lose to the enumeration it replaced, wherever that enumeration finishes
+
+#include <algorithm>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <vector>
+#include "TestSupport.h"
+
+using namespace std;
+
+typedef map<int, int> Front;  // hops -> width of the front point with that many hops
+
+///@return the widest edge from v to w, 0 if there's none
+static int widestEdge(Graph<int> &graph, int v, int w) {
+    int res = 0;
+    for (const Edge<int> &edge : graph.findVertex(v)->getAdj())
+        if (edge.getDest()->getInfo() == w) res = max(res, edge.getCapacity());
+    return res;
+}
+
+///@return the points of paths that no other path beats, being shorter and at least as wide or as short and wider
+static Front frontOf(const map<int, int> &widestByHops) {
+    Front res;
+    int widest = 0;
+    for (auto [hops, width] : widestByHops) {
+        if (width <= widest) continue;
+        res[hops] = width;
+        widest = width;
+    }
+    return res;
+}
+
+///The front from its definition: the widest walk with at most k edges, for k = 1, 2... until no walk gets wider
+static Front dynamicFront(Graph<int> &graph, int s, int t) {
+    int n = graph.getNumVertex();
+    vector<int> width(n + 1, 0), next;
+    width[s] = INF;
+    map<int, int> widestByHops;
+    for (int hops = 1; hops < n; hops++) {
+        next = width;
+        for (const Vertex<int> *v : graph.getVertexSet()) {
+            if (width[v->getInfo()] == 0) continue;
+            for (const Edge<int> &edge : v->getAdj()) {
+                int &w = next[edge.getDest()->getInfo()];
+                w = max(w, min(width[v->getInfo()], edge.getCapacity()));
+            }
+        }
+        if (next == width) break;
+        width.swap(next);
+        if (width[t] > 0) widestByHops[hops] = width[t];
+    }
+    return frontOf(widestByHops);
+}
+
+///The enumeration paretoOptimalGroupSizeAndTransportShift used to run: the breadth-first and the widest paths,
+///plus every simple path over edges wider than the breadth-first one with no more vertices than the widest one
+struct OldEnumeration {
+    Graph<int> &graph;
+    int target, minCapacity, maxVertices;
+    long long steps = 0;        // left before giving up
+    vector<int> path;
+    vector<char> onPath;
+    map<int, int> widestByHops;
+
+    ///@return false if it ran out of steps
+    bool search(int v, int width) {
+        if (--steps < 0) return false;
+        if (onPath[v]) return true;
+        path.push_back(v);
+        if (v == target) add((int) path.size() - 1, width);
+        else {
+            onPath[v] = 1;
+            for (const Edge<int> &edge : graph.findVertex(v)->getAdj()) {
+                if (edge.getCapacity() <= minCapacity || (int) path.size() >= maxVertices) continue;
+                if (!search(edge.getDest()->getInfo(), min(width, edge.getCapacity()))) return false;
+            }
+            onPath[v] = 0;
+        }
+        path.pop_back();
+        return true;
+    }
+
+    void add(int hops, int width) {
+        widestByHops[hops] = max(widestByHops[hops], width);
+    }
+};
+
+///@return the old enumeration's front, or an empty one if it didn't finish in the given steps
+static Front oldFront(Graph<int> &graph, int s, int t, long long steps) {
+    graph.unweightedShortestPath(s);
+    vector<int> shortest = graph.getPath(s, t);
+    if (shortest.empty()) return {};
+    int shortestWidth = INF;
+    for (size_t i = 0; i + 1 < shortest.size(); i++)
+        shortestWidth = min(shortestWidth, widestEdge(graph, shortest[i], shortest[i + 1]));
+    int widestWidth = graph.firstAlgorithm(s, t);
+    int widestVertices = graph.getPath(s, t).size();
+    OldEnumeration old{graph, t, shortestWidth, widestVertices, steps, {}, vector<char>(graph.getNumVertex() + 1), {}};
+    if (!old.search(s, INF)) return {};
+    old.add((int) shortest.size() - 1, shortestWidth);
+    old.add(widestVertices - 1, widestWidth);
+    return frontOf(old.widestByHops);
+}
+
+static void checkPair(const string &query, Graph<int> &graph, int s, int t, int &oldFinished) {
+    graph.paretoOptimalGroupSizeAndTransportShift(s, t);
+    Front front;
+    bool valid = true;
+    for (int id = 0; id < graph.paths.size(); id++) {
+        vector<int> path = graph.paths.getPath(id);
+        int width = INF;
+        for (size_t i = 0; i + 1 < path.size(); i++) width = min(width, widestEdge(graph, path[i], path[i + 1]));
+        vector<int> sorted = path;
+        sort(sorted.begin(), sorted.end());
+        valid = valid && path.size() > 1 && path.front() == s && path.back() == t && width == graph.paths.getAmount(id)
+                && adjacent_find(sorted.begin(), sorted.end()) == sorted.end() && !front.count(path.size() - 1);
+        front[path.size() - 1] = graph.paths.getAmount(id);
+    }
+    expect(valid, query + ": one simple path per hop count, as wide as its amount");
+    expect(front == frontOf(front), query + ": a path of the front is dominated");
+    expect(front == dynamicFront(graph, s, t), query + ": front differs from the dynamic program's");
+
+    Front old = oldFront(graph, s, t, 200000);
+    if (old.empty()) return;
+    oldFinished++;
+    for (auto [hops, width] : old) {
+        auto beaten = front.upper_bound(hops);
+        expect(beaten != front.begin() && prev(beaten)->second >= width, query + ": the old enumeration's path of "
+               + to_string(hops) + " hops, " + to_string(width) + " wide, beats the front");
+    }
+}
+
+int main(int argc, char *argv[]) {
+    for (const string &path : datasets(datasetDir(argc, argv))) {
+        string file = filesystem::path(path).filename().string();
+        if (file < "in01" || file >= "in07") continue;
+        Graph<int> graph;
+        loadDataset(path, graph);
+        vector<int> sample = sampleVertices(graph.getNumVertex(), 6);
+        int oldFinished = 0;
+        for (int s : sample) {
+            for (int t : sample) {
+                if (s != t) checkPair(path + ": " + to_string(s) + " -> " + to_string(t), graph, s, t, oldFinished);
+            }
+        }
+        expect(oldFinished > 0, path + ": the old enumeration never finished");
+    }
+    return finish("pareto_check");
+}
@@ -0,0 +1,101 @@
+// Checks PathStore's deduplication against a plain list of distinct paths, through random sequences of adds, wide
+// commits, merges and clears over paths short enough to repeat often, prefixes of each other and empty ones included
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "PathStore.h"
+#include "TestSupport.h"
+
+using namespace std;
+
+///The store as a list: paths in the order they were first committed, with their amounts
+struct Reference {
+    vector<vector<int>> paths;
+    vector<int> amounts;
+
+    void commit(const vector<int> &path, int amount, bool widest) {
+        auto found = find(paths.begin(), paths.end(), path);
+        if (found == paths.end()) {
+            paths.push_back(path);
+            amounts.push_back(amount);
+            return;
+        }
+        int &stored = amounts[found - paths.begin()];
+        stored = widest ? max(stored, amount) : stored + amount;
+    }
+
+    void add(const Reference &other, bool widest) {
+        for (size_t i = 0; i < other.paths.size(); i++) commit(other.paths[i], other.amounts[i], widest);
+    }
+};
+
+static bool same(const PathStore<int> &store, const Reference &reference) {
+    if (store.size() != (int) reference.paths.size() || store.empty() != reference.paths.empty()) return false;
+    for (int id = 0; id < store.size(); id++) {
+        if (store.getPath(id) != reference.paths[id] || store.getAmount(id) != reference.amounts[id]
+            || store.getLength(id) != (int) reference.paths[id].size()) return false;
+    }
+    vector<int> order = store.lexicographicOrder();
+    return is_sorted(order.begin(), order.end(), [&reference](int a, int b) {
+        return reference.paths[a] < reference.paths[b];
+    }) && (int) order.size() == store.size();
+}
+
+int main() {
+    unsigned seed = 1;
+    auto next = [&seed](int bound) {
+        seed = seed * 1103515245 + 12345;
+        return (int) ((seed >> 8) % bound);
+    };
+    PathStore<int> store, other;
+    Reference reference, otherReference;
+    for (int round = 0; round < 200; round++) {
+        // every 20th round stores thousands of distinct paths, so the hash table has to grow several times
+        bool large = round % 20 == 0;
+        int operations = next(large ? 5000 : 60), alphabet = large ? 50 : 3;
+        for (int op = 0; op < operations; op++) {
+            vector<int> path(next(5));
+            for (int &node : path) node = next(alphabet);
+            int amount = 1 + next(9);
+            switch (next(5)) {
+                case 0: {
+                    int id = store.add(path, amount);
+                    reference.commit(path, amount, false);
+                    expect(id < (int) reference.paths.size() && reference.paths[id] == path,
+                           "round " + to_string(round) + ": add gives the id of the path");
+                    break;
+                }
+                case 1:
+                    for (int node : path) store.push(node);
+                    store.commitMax(amount);
+                    reference.commit(path, amount, true);
+                    break;
+                case 2:
+                    for (auto node = path.rbegin(); node != path.rend(); node++) store.push(*node);
+                    store.reverseOpen();
+                    store.commit(amount);
+                    reference.commit(path, amount, false);
+                    break;
+                default:
+                    other.add(path, amount);
+                    otherReference.commit(path, amount, false);
+            }
+        }
+        expect(same(other, otherReference), "round " + to_string(round) + ": paths added one by one");
+        bool widest = next(2);
+        if (widest) store.addMax(other);
+        else store.add(other);
+        reference.add(otherReference, widest);
+        expect(same(store, reference), "round " + to_string(round) + ": after merging another store"
+                                       + (widest ? " by width" : " by sum"));
+        other.clear();
+        otherReference = Reference();
+        if (next(4) == 0) {
+            store.clear();
+            reference = Reference();
+            expect(same(store, reference), "round " + to_string(round) + ": cleared");
+        }
+    }
+    return finish("path_store_check");
+}
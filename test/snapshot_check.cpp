@@ -0,0 +1,101 @@
+// Round-trips every dataset through a snapshot file: the mapped arrays and the graph rebuilt from them must match
+// the loaded graph, and damaged files must be rejected
+
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "CsrGraph.h"
+#include "GraphSnapshot.h"
+#include "TestSupport.h"
+
+using namespace std;
+
+static bool sameGraph(const CsrGraph<int> &a, const CsrGraph<int> &b) {
+    if (a.getNumVertex() != b.getNumVertex() || a.getNumEdges() != b.getNumEdges()) return false;
+    for (int v = 0; v < a.getNumVertex(); v++) {
+        if (a.getInfo(v) != b.getInfo(v) || a.edgesBegin(v) != b.edgesBegin(v)) return false;
+    }
+    for (int e = 0; e < a.getNumEdges(); e++) {
+        if (a.getDest(e) != b.getDest(e) || a.getCapacity(e) != b.getCapacity(e)
+            || a.getDuration(e) != b.getDuration(e)) return false;
+    }
+    return true;
+}
+
+static bool sameArrays(const CsrGraph<int> &csr, const GraphSnapshot &snapshot) {
+    if (csr.getNumVertex() != snapshot.getNumVertex() || csr.getNumEdges() != snapshot.getNumEdges()) return false;
+    for (int v = 0; v < csr.getNumVertex(); v++) {
+        if (csr.getInfo(v) != snapshot.info()[v] || csr.edgesBegin(v) != snapshot.offsets()[v]) return false;
+    }
+    for (int e = 0; e < csr.getNumEdges(); e++) {
+        if (csr.getDest(e) != snapshot.dest()[e] || csr.getCapacity(e) != snapshot.capacity()[e]
+            || csr.getDuration(e) != snapshot.duration()[e]) return false;
+    }
+    return snapshot.offsets()[csr.getNumVertex()] == csr.getNumEdges();
+}
+
+static vector<char> readBytes(const string &path) {
+    ifstream stream(path, ios::binary);
+    return vector<char>(istreambuf_iterator<char>(stream), istreambuf_iterator<char>());
+}
+
+static void writeBytes(const string &path, const vector<char> &bytes) {
+    ofstream(path, ios::binary | ios::trunc).write(bytes.data(), bytes.size());
+}
+
+///Damages a valid snapshot in a few ways, each of which open must reject with the given reason
+static void checkRejected(const string &name, const string &path) {
+    vector<char> bytes = readBytes(path);
+    if (bytes.size() <= sizeof(SnapshotHeader)) {
+        expect(false, name + ": snapshot has no payload");
+        return;
+    }
+    string damaged = path + ".damaged", error;
+    GraphSnapshot snapshot;
+
+    vector<char> flipped = bytes;
+    flipped[flipped.size() - 1] ^= 1;
+    writeBytes(damaged, flipped);
+    expect(!snapshot.open(damaged, error) && error == "snapshot checksum mismatch", name + ": flipped payload byte");
+
+    writeBytes(damaged, vector<char>(bytes.begin(), bytes.end() - 4));
+    expect(!snapshot.open(damaged, error) && error == "snapshot size doesn't match its header", name + ": truncated");
+
+    vector<char> version = bytes;
+    version[offsetof(SnapshotHeader, version)]++;
+    writeBytes(damaged, version);
+    expect(!snapshot.open(damaged, error) && error.rfind("unsupported snapshot version", 0) == 0,
+           name + ": unknown version");
+    expect(!isSnapshotFile(name), name + ": a text dataset taken for a snapshot");
+    remove(damaged.c_str());
+}
+
+int main(int argc, char *argv[]) {
+    string path = (filesystem::temp_directory_path() / "proj2_snapshot_check.snap").string();
+    for (const string &dataset : datasets(datasetDir(argc, argv))) {
+        Graph<int> graph;
+        loadDataset(dataset, graph);
+        CsrGraph<int> csr(graph);
+        string error;
+        expect(writeSnapshot(graph, path, error), dataset + ": write: " + error);
+        expect(isSnapshotFile(path), dataset + ": snapshot not recognised");
+
+        GraphSnapshot snapshot;
+        if (!snapshot.open(path, error)) {
+            expect(false, dataset + ": open: " + error);
+            continue;
+        }
+        expect(sameArrays(csr, snapshot), dataset + ": mapped arrays differ from the graph");
+        Graph<int> rebuilt;
+        expect(snapshot.toGraph(rebuilt), dataset + ": toGraph");
+        expect(rebuilt.getNumberNodes() == graph.getNumberNodes() && rebuilt.getNumberEdges() == graph.getNumberEdges(),
+               dataset + ": rebuilt header counts");
+        expect(sameGraph(csr, CsrGraph<int>(rebuilt)), dataset + ": rebuilt graph differs from the loaded one");
+        checkRejected(dataset, path);
+    }
+    remove(path.c_str());
+    return finish("snapshot_check");
+}
@@ -0,0 +1,66 @@
+// Checks that a WidestPathTable answers like the queries it precomputes: from sampled sources of every dataset its
+// widths and paths must be those of QueryWorkspace::widestPath to every vertex, and those of Graph::firstAlgorithm
+// to sampled targets. The table of every source is checked on the small datasets
+
+#include <algorithm>
+#include <string>
+#include <vector>
+#include "CsrGraph.h"
+#include "QueryWorkspace.h"
+#include "TestSupport.h"
+#include "WidestPathTable.h"
+
+using namespace std;
+
+///Compares the rows of the given sources, by value, with the workspace's answers to every vertex
+static void checkRows(const string &name, const CsrGraph<int> &csr, const WidestPathTable<int> &table,
+                      const vector<int> &sources) {
+    QueryWorkspace<int> workspace(csr);
+    for (int s : sources) {
+        int si = csr.findVertexIdx(s), wrong = 0;
+        expect(table.hasSource(si), name + ": " + to_string(s) + " has a row");
+        workspace.widestPath(si, si);  // the widths and predecessors of every vertex, whatever the target
+        for (int ti = 0; ti < csr.getNumVertex(); ti++) {
+            wrong += table.getWidth(si, ti) != workspace.getCap(ti);
+            wrong += table.getPath(si, ti) != workspace.getPath(si, ti);
+        }
+        expect(wrong == 0, name + ": from " + to_string(s) + ", " + to_string(wrong) + " widths and paths differ");
+    }
+}
+
+int main(int argc, char *argv[]) {
+    for (const string &path : datasets(datasetDir(argc, argv))) {
+        Graph<int> graph;
+        loadDataset(path, graph);
+        CsrGraph<int> csr(graph);
+        int n = graph.getNumVertex();
+        vector<int> sample = sampleVertices(n, 6), sources;
+        for (int s : sample) sources.push_back(csr.findVertexIdx(s));
+        sources.push_back(sources.front());
+        WidestPathTable<int> table(csr, sources, 3);
+        expect(table.getNumSources() == (int) sample.size(), path + ": a repeated source gets a single row");
+        for (int v = 1; v <= n; v++) {
+            if (find(sample.begin(), sample.end(), v) != sample.end()) continue;
+            expect(!table.hasSource(csr.findVertexIdx(v)), path + ": a row for " + to_string(v) + ", not a source");
+            break;
+        }
+        checkRows(path, csr, table, sample);
+        for (int s : sample) {
+            for (int t : sample) {
+                if (s == t) continue;
+                int si = csr.findVertexIdx(s), ti = csr.findVertexIdx(t);
+                string query = path + ": " + to_string(s) + " -> " + to_string(t);
+                expect(table.getWidth(si, ti) == graph.firstAlgorithm(s, t), query + ", width of the Graph's");
+                expect(table.getPath(si, ti) == graph.getPath(s, t), query + ", path of the Graph's");
+            }
+        }
+        if (n <= 100) {
+            WidestPathTable<int> every(csr, 2);
+            vector<int> all;
+            for (int v = 1; v <= n; v++) all.push_back(v);
+            expect(every.getNumSources() == n, path + ": a row for every vertex");
+            checkRows(path + ", every source", csr, every, all);
+        }
+    }
+    return finish("widest_table_check");
+}